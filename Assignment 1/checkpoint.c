@@ -0,0 +1,144 @@
+/*
+*	Checkpoints for long batch runs. A checkpoint is only written once the output it points to is on disk, and it is
+*	written to a temporary file that is renamed over the old checkpoint, so the checkpoint file is always either the old
+*	checkpoint or the new one and never half of each.
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "checkpoint.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	Write one checkpoint to disk. It returns 0 on success and -1 on failure.
+*/
+static int write_checkpoint(struct checkpointer* cp, struct checkpoint* ckpt) {
+	// the rows the checkpoint counts as done have to be in the output file before the checkpoint says so
+	if (fsync(cp->output_fd) == -1) {
+		fprintf(stderr, "could not sync the output: %s\n", strerror(errno));
+		return -1;
+	}
+
+	char* temp_path = (char*)malloc(strlen(cp->path) + 5);
+	if (temp_path == NULL) {
+		fprintf(stderr, "could not allocate the path of the checkpoint %s\n", cp->path);
+		return -1;
+	}
+	sprintf(temp_path, "%s.tmp", cp->path);
+	FILE* file = fopen(temp_path, "w");
+	if (file == NULL) {
+		fprintf(stderr, "could not write the checkpoint %s: %s\n", temp_path, strerror(errno));
+		free(temp_path);
+		return -1;
+	}
+	// the last checkpoint is only replaced once all of the new one is on the disk
+	int written = fprintf(file, "%ld %ld %ld\n", ckpt->rows, ckpt->input_offset, ckpt->output_offset) >= 0
+		&& fflush(file) == 0 && fsync(fileno(file)) == 0;
+	if (!written) {
+		fprintf(stderr, "could not write the checkpoint %s: %s\n", temp_path, strerror(errno));
+	}
+	if (fclose(file) != 0 && written) {
+		fprintf(stderr, "could not close the checkpoint %s: %s\n", temp_path, strerror(errno));
+		written = FALSE;
+	}
+	if (!written) {
+		remove(temp_path);
+		free(temp_path);
+		return -1;
+	}
+
+	int status = rename(temp_path, cp->path);
+	if (status == -1) {
+		fprintf(stderr, "could not replace the checkpoint %s: %s\n", cp->path, strerror(errno));
+	}
+	free(temp_path);
+	return status;
+}
+
+/*
+*	This is the checkpoint thread. It sleeps until a checkpoint is handed to it, and writes it outside of the lock
+*	so that the loop over the rows can hand over the next one in the meantime.
+*/
+static void* checkpoint_thread(void* arg) {
+	struct checkpointer* cp = (struct checkpointer*)arg;
+	pthread_mutex_lock(&cp->lock);
+	while (TRUE) {
+		while (!cp->has_pending && !cp->stopping) {
+			pthread_cond_wait(&cp->changed, &cp->lock);
+		}
+		if (!cp->has_pending && cp->stopping) {
+			break;
+		}
+		struct checkpoint ckpt = cp->pending;
+		cp->has_pending = FALSE;
+		pthread_mutex_unlock(&cp->lock);
+
+		write_checkpoint(cp, &ckpt);
+
+		pthread_mutex_lock(&cp->lock);
+	}
+	pthread_mutex_unlock(&cp->lock);
+	return NULL;
+}
+
+/*
+*	Start the thread that writes checkpoints to path. output_fd is the output file, which is synced to disk before
+*	a checkpoint that points into it is written. It returns 0 on success and -1 on failure.
+*/
+int start_checkpointer(struct checkpointer* cp, char* path, int output_fd) {
+	cp->path = path;
+	cp->output_fd = output_fd;
+	cp->has_pending = FALSE;
+	cp->stopping = FALSE;
+	pthread_mutex_init(&cp->lock, NULL);
+	pthread_cond_init(&cp->changed, NULL);
+	if (pthread_create(&cp->thread, NULL, checkpoint_thread, cp) != 0) {
+		fprintf(stderr, "could not start the checkpoint thread\n");
+		return -1;
+	}
+	return 0;
+}
+
+/*
+*	Hand a checkpoint to the thread. The output written so far must already be flushed out of stdio, so that the
+*	output offset is the length of the file. This only takes the lock, it never waits for the disk.
+*/
+void post_checkpoint(struct checkpointer* cp, struct checkpoint* ckpt) {
+	pthread_mutex_lock(&cp->lock);
+	cp->pending = *ckpt;
+	cp->has_pending = TRUE;
+	pthread_cond_signal(&cp->changed);
+	pthread_mutex_unlock(&cp->lock);
+}
+
+/*
+*	Write the last checkpoint that was handed over (if any) and stop the thread
+*/
+void stop_checkpointer(struct checkpointer* cp) {
+	pthread_mutex_lock(&cp->lock);
+	cp->stopping = TRUE;
+	pthread_cond_signal(&cp->changed);
+	pthread_mutex_unlock(&cp->lock);
+	pthread_join(cp->thread, NULL);
+	pthread_mutex_destroy(&cp->lock);
+	pthread_cond_destroy(&cp->changed);
+}
+
+/*
+*	Read the checkpoint at path. It returns 0 on success and -1 if there is no checkpoint or it cannot be read.
+*/
+int read_checkpoint(char* path, struct checkpoint* ckpt) {
+	FILE* file = fopen(path, "r");
+	if (file == NULL) {
+		return -1;
+	}
+	int n = fscanf(file, "%ld %ld %ld", &ckpt->rows, &ckpt->input_offset, &ckpt->output_offset);
+	fclose(file);
+	return n == 3 ? 0 : -1;
+}
@@ -0,0 +1,53 @@
+#include <pthread.h>
+
+/*
+*	A checkpoint is the point a batch run can be picked back up from: the number of rows finished, the offset in the
+*	input file of the first row that is not finished, and the length of the output file once those rows were written.
+*
+*	The rows are evaluated independently of each other, so these offsets are the whole state of a run.
+*/
+struct checkpoint {
+	long rows;
+	long input_offset;
+	long output_offset;
+};
+
+/*
+*	The checkpointer is a thread that writes the checkpoints, so the loop over the rows only has to hand it the
+*	offsets. If the loop hands over a new checkpoint before the last one was written, only the newest one is written.
+*/
+struct checkpointer {
+	char* path;
+	int output_fd;
+
+	pthread_t thread;
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	struct checkpoint pending;
+	int has_pending;
+	int stopping;
+};
+
+
+
+/*
+*	Start the thread that writes checkpoints to path. output_fd is the output file, which is synced to disk before
+*	a checkpoint that points into it is written. It returns 0 on success and -1 on failure.
+*/
+int start_checkpointer(struct checkpointer* cp, char* path, int output_fd);
+
+/*
+*	Hand a checkpoint to the thread. The output written so far must already be flushed out of stdio, so that the
+*	output offset is the length of the file. This only takes the lock, it never waits for the disk.
+*/
+void post_checkpoint(struct checkpointer* cp, struct checkpoint* ckpt);
+
+/*
+*	Write the last checkpoint that was handed over (if any) and stop the thread
+*/
+void stop_checkpointer(struct checkpointer* cp);
+
+/*
+*	Read the checkpoint at path. It returns 0 on success and -1 if there is no checkpoint or it cannot be read.
+*/
+int read_checkpoint(char* path, struct checkpoint* ckpt);
@@ -0,0 +1,706 @@
+/*
+*	This is the coordinator for the precedence graph. Unlike the semaphore version in pipes_process_sync.c, where the
+*	parent hands one line to one child and waits for it before reading the next line, the coordinator holds the
+*	connections of every worker open at once. It sends an edge to a worker as soon as the value the edge reads is known,
+*	and it handles the replies in whatever order the workers finish them.
+*
+*	Workers never talk to each other. When an edge reads an internal variable, the coordinator already has the value
+*	from the RESULT of the edge that wrote it, and it puts the value inside the APPLY message. The messages for a worker
+*	are gathered and sent in one write per round, which matters most when the worker is on the other end of a socket.
+*/
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+#include "values.h"
+#include "precedence_graph.h"
+#include "coordinator.h"
+#include "trace.h"
+#include "kernels.h"
+#include "profiler.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	This is the set of connections the coordinator is waiting on. On Linux it is an epoll instance, and
+*	elsewhere (the assignment was also written on macOS) it falls back to an array for poll.
+*/
+struct reply_watch {
+#ifdef __linux__
+	int epoll_fd;
+	struct epoll_event* events;
+#else
+	struct pollfd* fds;
+#endif
+	int n;
+	int* ready;
+};
+
+/*
+*	Say why an edge left the value of a variable as it was. The worker keeps going, since otherwise the coordinator
+*	would wait on it forever.
+*/
+void report_kernel_error(int error, int type, union value value) {
+	fprintf(stderr, error == KERNEL_OVERFLOW ? "overflow in precedence graph, value left as " : "division by zero in precedence graph, value left as ");
+	print_value(stderr, type, value);
+	fprintf(stderr, "\n");
+}
+
+/*
+*	Write all of a buffer, even if the write is cut short
+*/
+static int write_all(int fd, void* data, size_t size) {
+	char* bytes = (char*)data;
+	while (size > 0) {
+		ssize_t n = write(fd, bytes, size);
+		if (n == -1) {
+			if (errno == EINTR) continue;
+			return -1;
+		}
+		bytes += n;
+		size -= n;
+	}
+	return 0;
+}
+
+/*
+*	Read every whole message that is waiting on a connection, at most READ_BATCH of them. A message that has only
+*	partly arrived is kept in partial until the rest of it comes, since a socket (unlike a pipe) can cut a message
+*	in two. It returns the number of messages, or -1 if the other end has closed the connection.
+*/
+static int read_messages(int fd, char* partial, int* buffered, struct message* out) {
+	char data[sizeof(struct message) * READ_BATCH];
+	memcpy(data, partial, *buffered);
+	ssize_t n = read(fd, data + *buffered, sizeof(data) - *buffered);
+	if (n == -1 && errno == EINTR) {
+		return 0;
+	}
+	if (n <= 0) {
+		return -1;
+	}
+	size_t total = *buffered + n;
+	int n_messages = total / sizeof(struct message);
+	memcpy(out, data, n_messages * sizeof(struct message));
+	*buffered = total - n_messages * sizeof(struct message);
+	memcpy(partial, data + n_messages * sizeof(struct message), *buffered);
+	return n_messages;
+}
+
+/*
+*	What a worker knows about the graph it is working on, from the HELLO message
+*/
+struct worker_state {
+	int worker_id;
+	int n_workers;
+	int n_internal_var;
+	int value_type;
+	int profiled;
+	union value* values;
+};
+
+/*
+*	For every type of value, this builds the function that applies a run of APPLY messages with that type's
+*	operators. It stops at the first message that is not an APPLY, and returns the number of messages it applied.
+*	The profiled version also times every edge and sends the times in a TIMING message after the RESULT; profiled is
+*	a constant, so the version that is not profiled does not read the clock at all.
+*/
+#define DEFINE_APPLY_RUN(name, suffix, profiled) \
+static int name##suffix(struct worker_state* w, struct message* in, int n_in, struct message* out, int* n_out) { \
+	int i = 0; \
+	for (; i < n_in && in[i].type == MSG_APPLY; i++) { \
+		struct message msg = in[i]; \
+		long start = profiled ? profile_now() : 0; \
+		int error = name##_apply(msg.op, &w->values[msg.var], msg.value); \
+		if (error != 0) { \
+			report_kernel_error(error, w->value_type, w->values[msg.var]); \
+		} \
+		msg.type = MSG_RESULT; \
+		msg.value = w->values[msg.var]; \
+		out[(*n_out)++] = msg; \
+		if (profiled) { \
+			msg.type = MSG_TIMING; \
+			msg.op = (int)(profile_now() - start); \
+			msg.value.i = start; \
+			out[(*n_out)++] = msg; \
+		} \
+	} \
+	return i; \
+}
+
+DEFINE_APPLY_RUN(int, _apply_run, FALSE)
+DEFINE_APPLY_RUN(int64, _apply_run, FALSE)
+DEFINE_APPLY_RUN(double, _apply_run, FALSE)
+DEFINE_APPLY_RUN(checked, _apply_run, FALSE)
+DEFINE_APPLY_RUN(int, _apply_run_profiled, TRUE)
+DEFINE_APPLY_RUN(int64, _apply_run_profiled, TRUE)
+DEFINE_APPLY_RUN(double, _apply_run_profiled, TRUE)
+DEFINE_APPLY_RUN(checked, _apply_run_profiled, TRUE)
+
+/*
+*	The functions above in the order of enum value_type, without and with profiling
+*/
+static int (*apply_runs[2][4])(struct worker_state*, struct message*, int, struct message*, int*) = {
+	{int_apply_run, int64_apply_run, double_apply_run, checked_apply_run},
+	{int_apply_run_profiled, int64_apply_run_profiled, double_apply_run_profiled, checked_apply_run_profiled}
+};
+
+/*
+*	This is what a worker process runs, over pipes or a socket. The HELLO message tells the worker which internal
+*	variables it owns (every one whose index is its number modulo the number of workers) and the type of their
+*	values, which picks the function that applies the edges (PROFILE picks the one that times them). It applies the
+*	edges it is sent in the order it receives them, and answers all of the messages it read at once with one write.
+*
+*	It returns once it is told to terminate or the coordinator closes the connection.
+*/
+void worker_loop(int in_fd, int out_fd) {
+	struct worker_state w;
+	w.worker_id = 0;
+	w.n_workers = 1;
+	w.n_internal_var = 0;
+	w.value_type = VALUE_INT;
+	w.profiled = FALSE;
+	w.values = NULL;
+	int (*apply_run)(struct worker_state*, struct message*, int, struct message*, int*) = apply_runs[FALSE][VALUE_INT];
+
+	char partial[sizeof(struct message)];
+	int buffered = 0;
+	struct message in[READ_BATCH];
+	struct message out[READ_BATCH * 10];
+	int terminate = FALSE;
+
+	while (!terminate) {
+		int n_in = read_messages(in_fd, partial, &buffered, in);
+		if (n_in == -1) {
+			break;
+		}
+		int n_out = 0;
+		int i = 0;
+		while (i < n_in && !terminate) {
+			if (in[i].type == MSG_APPLY) {
+				i += apply_run(&w, in + i, n_in - i, out, &n_out);
+				continue;
+			}
+			struct message msg = in[i++];
+			if (msg.type == MSG_HELLO) {
+				w.worker_id = msg.edge;
+				w.n_workers = msg.var;
+				w.n_internal_var = msg.op;
+				w.value_type = msg.value.i >= VALUE_INT && msg.value.i <= VALUE_CHECKED ? msg.value.i : VALUE_INT;
+				apply_run = apply_runs[w.profiled][w.value_type];
+				free(w.values);
+				w.values = (union value*)calloc(w.n_internal_var + 1, sizeof(union value));
+			} else if (msg.type == MSG_PROFILE) {
+				w.profiled = msg.value.i != 0;
+				apply_run = apply_runs[w.profiled][w.value_type];
+			} else if (msg.type == MSG_COLLECT) {
+				for (int v = w.worker_id; v < w.n_internal_var; v += w.n_workers) {
+					msg.type = MSG_FINAL;
+					msg.edge = -1;
+					msg.var = v;
+					msg.value = w.values[v];
+					out[n_out++] = msg;
+					w.values[v].i = 0;
+				}
+			} else if (msg.type == MSG_TERMINATE) {
+				terminate = TRUE;
+			}
+		}
+		if (n_out > 0 && write_all(out_fd, out, n_out * sizeof(struct message)) == -1) {
+			break;
+		}
+	}
+	free(w.values);
+}
+
+/*
+*	Set up a channel for a worker whose connection has just been made
+*/
+void init_channel(struct channel* ch, int pid, int to_worker, int from_worker) {
+	ch->pid = pid;
+	ch->id = -1;
+	ch->to_worker = to_worker;
+	ch->from_worker = from_worker;
+	ch->in_flight = 0;
+	ch->buffered = 0;
+	ch->n_outgoing = 0;
+	ch->bytes_sent = 0;
+	ch->bytes_received = 0;
+	ch->trace = NULL;
+}
+
+/*
+*	Record every message that goes over the channels in the trace, with channel i as worker i
+*/
+void record_channels(struct channel* channels, int n_workers, struct trace_writer* trace) {
+	for (int w = 0; w < n_workers; w++) {
+		channels[w].id = w;
+		channels[w].trace = trace;
+	}
+}
+
+/*
+*	Fork the workers. Each one gets its own pair of pipes, and closes every pipe end that belongs to someone else so
+*	that it sees the end of its input once the coordinator closes it.
+*/
+int start_pipe_workers(struct channel* channels, int n_workers) {
+	for (int w = 0; w < n_workers; w++) {
+		init_channel(&channels[w], -1, -1, -1);
+	}
+	fflush(stdout);
+	for (int w = 0; w < n_workers; w++) {
+		int to_worker[2];
+		int from_worker[2];
+		if (pipe(to_worker) == -1 || pipe(from_worker) == -1) {
+			fprintf(stderr, "pipe failed: %s\n", strerror(errno));
+			return -1;
+		}
+		int pid = fork();
+		if (pid == -1) {
+			fprintf(stderr, "fork failed: %s\n", strerror(errno));
+			return -1;
+		}
+		if (!pid) {
+			for (int i = 0; i < w; i++) {
+				close(channels[i].to_worker);
+				close(channels[i].from_worker);
+			}
+			close(to_worker[1]);
+			close(from_worker[0]);
+			worker_loop(to_worker[0], from_worker[1]);
+			close(to_worker[0]);
+			close(from_worker[1]);
+			exit(EXIT_SUCCESS);
+		}
+		close(to_worker[0]);
+		close(from_worker[1]);
+		init_channel(&channels[w], pid, to_worker[1], from_worker[0]);
+	}
+	return 0;
+}
+
+/*
+*	Start watching the connection of every channel
+*/
+static struct reply_watch* watch_init(struct channel* channels, int n) {
+	struct reply_watch* watch = (struct reply_watch*)malloc(sizeof(struct reply_watch));
+	watch->n = n;
+	watch->ready = (int*)malloc(sizeof(int) * n);
+#ifdef __linux__
+	watch->epoll_fd = epoll_create1(0);
+	watch->events = (struct epoll_event*)malloc(sizeof(struct epoll_event) * n);
+	for (int i = 0; i < n; i++) {
+		struct epoll_event ev;
+		ev.events = EPOLLIN;
+		ev.data.u32 = i;
+		epoll_ctl(watch->epoll_fd, EPOLL_CTL_ADD, channels[i].from_worker, &ev);
+	}
+#else
+	watch->fds = (struct pollfd*)malloc(sizeof(struct pollfd) * n);
+	for (int i = 0; i < n; i++) {
+		watch->fds[i].fd = channels[i].from_worker;
+		watch->fds[i].events = POLLIN;
+	}
+#endif
+	return watch;
+}
+
+/*
+*	Block until at least one worker has replied, and fill watch->ready with the indices of the channels that can be read.
+*	It returns the number of ready channels, or -1 on error.
+*/
+static int watch_wait(struct reply_watch* watch) {
+	int n_ready = 0;
+#ifdef __linux__
+	int n = epoll_wait(watch->epoll_fd, watch->events, watch->n, -1);
+	if (n == -1) {
+		return errno == EINTR ? 0 : -1;
+	}
+	for (int i = 0; i < n; i++) {
+		watch->ready[n_ready++] = watch->events[i].data.u32;
+	}
+#else
+	int n = poll(watch->fds, watch->n, -1);
+	if (n == -1) {
+		return errno == EINTR ? 0 : -1;
+	}
+	for (int i = 0; i < watch->n; i++) {
+		if (watch->fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+			watch->ready[n_ready++] = i;
+		}
+	}
+#endif
+	return n_ready;
+}
+
+static void watch_destroy(struct reply_watch* watch) {
+#ifdef __linux__
+	close(watch->epoll_fd);
+	free(watch->events);
+#else
+	free(watch->fds);
+#endif
+	free(watch->ready);
+	free(watch);
+}
+
+/*
+*	Send every message waiting on a channel in one write
+*/
+int flush_channel(struct channel* ch) {
+	if (ch->n_outgoing == 0) {
+		return 0;
+	}
+	if (ch->trace != NULL) {
+		trace_messages(ch->trace, ch->id, TRACE_SENT, ch->outgoing, ch->n_outgoing);
+	}
+	size_t size = ch->n_outgoing * sizeof(struct message);
+	if (write_all(ch->to_worker, ch->outgoing, size) == -1) {
+		fprintf(stderr, "write to worker failed: %s\n", strerror(errno));
+		return -1;
+	}
+	ch->bytes_sent += size;
+	ch->n_outgoing = 0;
+	return 0;
+}
+
+/*
+*	Add a message to the ones waiting to be sent on a channel
+*/
+int queue_message(struct channel* ch, struct message* msg) {
+	if (ch->n_outgoing == MAX_IN_FLIGHT + 1 && flush_channel(ch) == -1) {
+		return -1;
+	}
+	ch->outgoing[ch->n_outgoing++] = *msg;
+	return 0;
+}
+
+/*
+*	Read the replies waiting on a channel into out
+*/
+int read_replies(struct channel* ch, struct message* out) {
+	int n = read_messages(ch->from_worker, ch->buffer, &ch->buffered, out);
+	if (n > 0) {
+		ch->bytes_received += n * sizeof(struct message);
+		if (ch->trace != NULL) {
+			trace_messages(ch->trace, ch->id, TRACE_RECEIVED, out, n);
+		}
+	}
+	return n;
+}
+
+/*
+*	Find the operand of an edge. It returns TRUE and sets value if the operand is known, and FALSE if
+*	the edges into the source that come before this edge have not been answered yet.
+*/
+static int operand_of(struct coordinator* co, struct edge* e, union value* value) {
+	if (e->src_is_input) {
+		*value = co->graph->input_var[e->src].value;
+		return TRUE;
+	}
+	if (co->completed[e->src] < e->src_version) {
+		return FALSE;
+	}
+	if (e->src_version == 0) {
+		value->i = 0;
+	} else {
+		*value = co->result[co->queue[co->queue_start[e->src] + e->src_version - 1]];
+	}
+	return TRUE;
+}
+
+/*
+*	Send every edge that can be sent. The edges into one variable are sent in the order of the file, since the
+*	worker applies them in the order it gets them, and the first one whose operand is unknown holds up the rest.
+*/
+static int dispatch_ready(struct coordinator* co) {
+	for (int v = 0; v < co->graph->n_internal_var; v++) {
+		struct channel* ch = &co->channels[v % co->n_workers];
+		int n_into = co->queue_start[v + 1] - co->queue_start[v];
+		while (co->cursor[v] < n_into && ch->in_flight < MAX_IN_FLIGHT) {
+			int e = co->queue[co->queue_start[v] + co->cursor[v]];
+			struct message msg;
+			if (!operand_of(co, &co->graph->edges[e], &msg.value)) {
+				break;
+			}
+			msg.type = MSG_APPLY;
+			msg.edge = e;
+			msg.var = v;
+			msg.op = co->graph->edges[e].op;
+			if (queue_message(ch, &msg) == -1) {
+				return -1;
+			}
+			ch->in_flight++;
+			co->cursor[v]++;
+			if (co->profile != NULL) {
+				profile_sent(co->profile, e);
+			}
+		}
+	}
+	if (co->profile != NULL) {
+		profile_stamp_sent(co->profile);
+	}
+	for (int w = 0; w < co->n_workers; w++) {
+		if (flush_channel(&co->channels[w]) == -1) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*
+*	Keep the times of the replies of a profiled row: when a RESULT came back, and when the worker applied the edge
+*/
+static void profile_replies(struct profile* p, struct message* replies, int n_replies) {
+	long now = profile_now();
+	for (int i = 0; i < n_replies; i++) {
+		if (replies[i].type == MSG_RESULT) {
+			p->row.done[replies[i].edge] = now;
+		} else if (replies[i].type == MSG_TIMING) {
+			p->row.applied[replies[i].edge] = replies[i].value.i;
+			p->row.apply_ns[replies[i].edge] = replies[i].op;
+		}
+	}
+}
+
+/*
+*	Get the coordinator ready to evaluate the graph with the workers on the given channels. Internal variable i
+*	is owned by worker i % n_workers. It returns 0 on success and -1 on failure.
+*/
+int coordinator_start(struct coordinator* co, struct precedence_graph* graph, struct channel* channels, int n_workers) {
+	int n_var = graph->n_internal_var;
+	co->graph = graph;
+	co->channels = channels;
+	co->n_workers = n_workers;
+	co->profile = NULL;
+	co->rows = 0;
+
+	/*
+	*	Group the edges by the variable they write to, keeping the order of the file within each group
+	*/
+	co->queue_start = (int*)calloc(n_var + 1, sizeof(int));
+	co->queue = (int*)malloc(sizeof(int) * (graph->n_edges + 1));
+	co->cursor = (int*)calloc(n_var + 1, sizeof(int));
+	co->completed = (int*)calloc(n_var + 1, sizeof(int));
+	co->result = (union value*)malloc(sizeof(union value) * (graph->n_edges + 1));
+	for (int e = 0; e < graph->n_edges; e++) {
+		co->queue_start[graph->edges[e].dst + 1]++;
+	}
+	for (int v = 0; v < n_var; v++) {
+		co->queue_start[v + 1] += co->queue_start[v];
+	}
+	int* fill = (int*)calloc(n_var + 1, sizeof(int));
+	for (int e = 0; e < graph->n_edges; e++) {
+		int v = graph->edges[e].dst;
+		co->queue[co->queue_start[v] + fill[v]++] = e;
+	}
+	free(fill);
+
+	co->watch = watch_init(channels, n_workers);
+
+	/*
+	*	Tell every worker which variables it owns
+	*/
+	for (int w = 0; w < n_workers; w++) {
+		struct message msg;
+		msg.type = MSG_HELLO;
+		msg.edge = w;
+		msg.var = n_workers;
+		msg.op = n_var;
+		msg.value.i = graph->value_type;
+		if (queue_message(&channels[w], &msg) == -1 || flush_channel(&channels[w]) == -1) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*
+*	Profile every row from now on. The workers are told to time the edges they apply.
+*/
+int coordinator_profile(struct coordinator* co, struct profile* p) {
+	co->profile = p;
+	struct message msg;
+	msg.type = MSG_PROFILE;
+	msg.edge = -1;
+	msg.var = -1;
+	msg.op = 0;
+	msg.value.i = TRUE;
+	for (int w = 0; w < co->n_workers; w++) {
+		if (queue_message(&co->channels[w], &msg) == -1 || flush_channel(&co->channels[w]) == -1) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*
+*	Evaluate the graph for the current values of the input variables. Every worker channel is watched at once
+*	with epoll (poll outside of Linux), so edges are dispatched to every worker that can take one and replies are
+*	handled in the order they complete.
+*
+*	When it returns, the values of graph->internal_var are the results. It returns 0 on success and -1 on failure.
+*/
+int coordinator_evaluate_row(struct coordinator* co) {
+	struct precedence_graph* graph = co->graph;
+	int n_var = graph->n_internal_var;
+	struct message replies[READ_BATCH];
+
+	for (int v = 0; v < n_var; v++) {
+		co->cursor[v] = 0;
+		co->completed[v] = 0;
+	}
+	co->n_completed = 0;
+	if (co->profile != NULL) {
+		profile_row_start(co->profile);
+	}
+
+	/*
+	*	Dispatch everything that can go, then keep handling replies and dispatching what they unblock until
+	*	every edge has been answered
+	*/
+	int status = dispatch_ready(co);
+	while (status == 0 && co->n_completed < graph->n_edges) {
+		int n_ready = watch_wait(co->watch);
+		if (n_ready == -1) {
+			status = -1;
+			break;
+		}
+		for (int r = 0; r < n_ready && status == 0; r++) {
+			struct channel* ch = &co->channels[co->watch->ready[r]];
+			int n_replies = read_replies(ch, replies);
+			if (n_replies == -1) {
+				fprintf(stderr, "worker %d stopped before the graph was finished\n", co->watch->ready[r]);
+				status = -1;
+			}
+			if (co->profile != NULL && n_replies > 0) {
+				profile_replies(co->profile, replies, n_replies);
+			}
+			for (int i = 0; i < n_replies; i++) {
+				if (replies[i].type != MSG_RESULT) {
+					continue;
+				}
+				co->result[replies[i].edge] = replies[i].value;
+				co->completed[replies[i].var]++;
+				co->n_completed++;
+				ch->in_flight--;
+			}
+		}
+		if (status == 0) {
+			status = dispatch_ready(co);
+		}
+	}
+
+	/*
+	*	Ask every worker for its values at once, and collect them in any order
+	*/
+	struct message msg;
+	msg.type = MSG_COLLECT;
+	msg.edge = -1;
+	msg.var = -1;
+	msg.op = 0;
+	msg.value.i = 0;
+	for (int w = 0; w < co->n_workers && status == 0; w++) {
+		if (queue_message(&co->channels[w], &msg) == -1 || flush_channel(&co->channels[w]) == -1) {
+			status = -1;
+		}
+	}
+	int n_final = 0;
+	while (status == 0 && n_final < n_var) {
+		int n_ready = watch_wait(co->watch);
+		if (n_ready == -1) {
+			status = -1;
+			break;
+		}
+		for (int r = 0; r < n_ready && status == 0; r++) {
+			int n_replies = read_replies(&co->channels[co->watch->ready[r]], replies);
+			if (n_replies == -1) {
+				fprintf(stderr, "worker %d stopped before sending its values\n", co->watch->ready[r]);
+				status = -1;
+			}
+			// the TIMING of the last edges is sent after their RESULT, so it can come with the FINALs
+			if (co->profile != NULL && n_replies > 0) {
+				profile_replies(co->profile, replies, n_replies);
+			}
+			for (int i = 0; i < n_replies; i++) {
+				if (replies[i].type == MSG_FINAL) {
+					graph->internal_var[replies[i].var].value = replies[i].value;
+					n_final++;
+				}
+			}
+		}
+	}
+
+	if (co->profile != NULL && status == 0) {
+		profile_row_end(co->profile);
+	}
+	co->rows++;
+	return status;
+}
+
+/*
+*	Close the channels and wait for the workers this process started. Closing the connections also ends any worker
+*	still waiting if something went wrong.
+*/
+void close_channels(struct channel* channels, int n_workers) {
+	for (int w = 0; w < n_workers; w++) {
+		close(channels[w].to_worker);
+		if (channels[w].from_worker != channels[w].to_worker) {
+			close(channels[w].from_worker);
+		}
+	}
+	for (int w = 0; w < n_workers; w++) {
+		if (channels[w].pid != -1) {
+			waitpid(channels[w].pid, NULL, 0);
+		}
+	}
+}
+
+/*
+*	Terminate every worker, close the channels and free what the coordinator allocated
+*/
+void coordinator_finish(struct coordinator* co) {
+	struct message msg;
+	msg.type = MSG_TERMINATE;
+	msg.edge = -1;
+	msg.var = -1;
+	msg.op = 0;
+	msg.value.i = 0;
+	for (int w = 0; w < co->n_workers; w++) {
+		queue_message(&co->channels[w], &msg);
+		flush_channel(&co->channels[w]);
+	}
+
+	close_channels(co->channels, co->n_workers);
+
+	watch_destroy(co->watch);
+	free(co->queue_start);
+	free(co->queue);
+	free(co->cursor);
+	free(co->completed);
+	free(co->result);
+}
+
+/*
+*	Print the number of bytes that went over the channels, per row and in total, to stderr
+*/
+void coordinator_print_stats(struct coordinator* co, double seconds) {
+	long sent = 0;
+	long received = 0;
+	for (int w = 0; w < co->n_workers; w++) {
+		sent += co->channels[w].bytes_sent;
+		received += co->channels[w].bytes_received;
+	}
+	long rows = co->rows > 0 ? co->rows : 1;
+	fprintf(stderr, "workers: %d  rows: %ld  bytes sent: %ld  bytes received: %ld  bytes per row: %.1f  time: %.3fs  rows per second: %.1f\n",
+		co->n_workers, co->rows, sent, received, (double)(sent + received) / rows, seconds, seconds > 0 ? co->rows / seconds : 0.0);
+}
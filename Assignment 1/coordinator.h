@@ -0,0 +1,185 @@
+/*
+*	These are the messages that travel between the coordinator (the parent process) and the worker processes.
+*	The coordinator sends HELLO, PROFILE, APPLY, COLLECT and TERMINATE, and the workers answer with RESULT, TIMING
+*	and FINAL.
+*/
+enum message_type {
+	MSG_HELLO,
+	MSG_APPLY,
+	MSG_RESULT,
+	MSG_COLLECT,
+	MSG_FINAL,
+	MSG_TERMINATE,
+	MSG_PROFILE,
+	MSG_TIMING
+};
+
+/*
+*	Every message has the same fixed size so that a write of one message to a pipe is atomic and
+*	a read can always be cut into whole messages. The messages are sent in the byte order of the machine,
+*	so the workers over TCP have to run on the same kind of machine as the coordinator.
+*
+*	For HELLO, edge is the number of the worker, var is the number of workers, op is the number of internal variables
+*	and value.i is the type of the values of the graph.
+*	For APPLY, value is the operand the worker combines into internal variable var using op.
+*	For RESULT and FINAL, value is the value of internal variable var afterwards.
+*	COLLECT asks for a FINAL for every variable the worker owns, and resets them to 0 for the next row.
+*	PROFILE with value.i set makes the worker send a TIMING after every RESULT, where value.i is the time the worker
+*	started applying the edge (on its own CLOCK_MONOTONIC, in nanoseconds) and op is how many nanoseconds it took.
+*/
+struct message {
+	int type;
+	int edge;
+	int var;
+	int op;
+	union value value;
+};
+
+/*
+*	The most APPLY messages a worker may have unanswered. The coordinator would otherwise be able to fill the pipe to
+*	a worker while the worker is stuck writing to a full pipe back to the coordinator.
+*/
+#define MAX_IN_FLIGHT 64
+
+/*
+*	The most messages read from one connection in one go
+*/
+#define READ_BATCH 64
+
+/*
+*	A channel is the connection the coordinator holds open to one worker, either a pair of pipes or a single TCP socket
+*	(in which case to_worker and from_worker are the same). It keeps the bytes of a message that has only partly arrived,
+*	and the messages waiting to be sent, which go out together in one write per round instead of one write each.
+*
+*	in_flight is the number of APPLY messages the worker has not answered yet, and pid is the worker process if the
+*	coordinator started it (-1 for a worker on another machine). If trace is set, every message that goes over the
+*	channel is recorded in it under the number id.
+*/
+struct trace_writer;
+
+struct channel {
+	int pid;
+	int id;
+	int to_worker;
+	int from_worker;
+	int in_flight;
+
+	int buffered;
+	char buffer[sizeof(struct message)];
+
+	int n_outgoing;
+	struct message outgoing[MAX_IN_FLIGHT + 1];
+
+	long bytes_sent;
+	long bytes_received;
+
+	struct trace_writer* trace;
+};
+
+struct precedence_graph;
+struct reply_watch;
+struct profile;
+
+/*
+*	This is everything the coordinator keeps about the evaluation of the graph.
+*
+*	The edges into each internal variable are stored back to back in queue, with the ones into variable v
+*	starting at queue[queue_start[v]]. cursor[v] is how many of them have been sent, completed[v] is how many of
+*	them have been answered, and result[e] is the value of the destination of edge e after the edge was applied.
+*/
+struct coordinator {
+	struct precedence_graph* graph;
+	struct channel* channels;
+	int n_workers;
+	struct reply_watch* watch;
+
+	int* queue_start;
+	int* queue;
+	int* cursor;
+	int* completed;
+	union value* result;
+	int n_completed;
+
+	struct profile* profile;
+	long rows;
+};
+
+
+
+/*
+*	Set up a channel for a worker whose connection has just been made
+*/
+void init_channel(struct channel* ch, int pid, int to_worker, int from_worker);
+
+/*
+*	Record every message that goes over the channels in the trace, with channel i as worker i
+*/
+void record_channels(struct channel* channels, int n_workers, struct trace_writer* trace);
+
+/*
+*	Add a message to the ones waiting to be sent on a channel. It returns 0 on success and -1 on failure.
+*/
+int queue_message(struct channel* ch, struct message* msg);
+
+/*
+*	Send every message waiting on a channel in one write. It returns 0 on success and -1 on failure.
+*/
+int flush_channel(struct channel* ch);
+
+/*
+*	Read the replies waiting on a channel into out, which has room for READ_BATCH messages. It blocks until at least
+*	part of a message arrives, and returns the number of whole messages, or -1 if the worker closed the connection.
+*/
+int read_replies(struct channel* ch, struct message* out);
+
+/*
+*	Close the channels and wait for the workers this process started
+*/
+void close_channels(struct channel* channels, int n_workers);
+
+/*
+*	Fork n_workers worker processes connected to the coordinator by pipes. It returns 0 on success and -1 on failure.
+*/
+int start_pipe_workers(struct channel* channels, int n_workers);
+
+/*
+*	Say why an edge left the value of a variable as it was (error is what a kernel of kernels.h returned)
+*/
+void report_kernel_error(int error, int type, union value value);
+
+/*
+*	This is what a worker process runs, over pipes or a socket. It returns once it is told to terminate or the
+*	coordinator closes the connection.
+*/
+void worker_loop(int in_fd, int out_fd);
+
+/*
+*	Get the coordinator ready to evaluate the graph with the workers on the given channels. Internal variable i
+*	is owned by worker i % n_workers. It returns 0 on success and -1 on failure.
+*/
+int coordinator_start(struct coordinator* co, struct precedence_graph* graph, struct channel* channels, int n_workers);
+
+/*
+*	Profile every row from now on. The workers are told to time the edges they apply.
+*	It returns 0 on success and -1 on failure.
+*/
+int coordinator_profile(struct coordinator* co, struct profile* p);
+
+/*
+*	Evaluate the graph for the current values of the input variables. Every worker channel is watched at once
+*	with epoll (poll outside of Linux), so edges are dispatched to every worker that can take one and replies are
+*	handled in the order they complete.
+*
+*	When it returns, the values of graph->internal_var are the results. It returns 0 on success and -1 on failure.
+*/
+int coordinator_evaluate_row(struct coordinator* co);
+
+/*
+*	Terminate every worker, close the channels and free what the coordinator allocated
+*/
+void coordinator_finish(struct coordinator* co);
+
+/*
+*	Print the number of bytes that went over the channels, per row and in total, to stderr
+*/
+void coordinator_print_stats(struct coordinator* co, double seconds);
@@ -0,0 +1,165 @@
+/*
+*	This program measures how fast the kernels of each type of value apply edges, the way a worker does: every edge
+*	brings its operand, and is applied to one of 10 variables. It compares them with the int version of
+*	apply_operation from before the values had types, and with a loop that picks the type for every edge instead of
+*	once, which is what the kernels avoid.
+*
+*	Compile it from this directory with
+*		gcc -O2 value_types_benchmark.c ../values.c -o value_types_benchmark
+*	and run it with the number of edges and passes to make (default 1048576 and 50).
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../values.h"
+#include "../precedence_graph.h"
+#include "../kernels.h"
+
+struct bench_edge {
+	int op;
+	int dst;
+	union value operand;
+};
+
+static double now_in_seconds() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+*	The int apply_operation of the coordinator before the values had types, without the message for a
+*	division by zero (the benchmark never divides by zero)
+*/
+static int apply_operation(int op, int current, int operand) {
+	if (op == OP_ASSIGN) {
+		return operand;
+	} else if (op == OP_ADD) {
+		return current + operand;
+	} else if (op == OP_SUB) {
+		return current - operand;
+	} else if (op == OP_MUL) {
+		return current * operand;
+	} else if (op == OP_DIV) {
+		if (operand == 0) {
+			return current;
+		}
+		return current / operand;
+	}
+	return current;
+}
+
+static long baseline_pass(struct bench_edge* edges, int n_edges, int* values) {
+	for (int e = 0; e < n_edges; e++) {
+		values[edges[e].dst] = apply_operation(edges[e].op, values[edges[e].dst], (int)edges[e].operand.i);
+	}
+	return 0;
+}
+
+/*
+*	One pass over the edges with the kernels of one type. It returns the number of edges that were refused.
+*/
+#define DEFINE_PASS(name) \
+static long name##_pass(struct bench_edge* edges, int n_edges, union value* values) { \
+	long errors = 0; \
+	for (int e = 0; e < n_edges; e++) { \
+		errors += name##_apply(edges[e].op, &values[edges[e].dst], edges[e].operand) != 0; \
+	} \
+	return errors; \
+}
+
+DEFINE_PASS(int)
+DEFINE_PASS(int64)
+DEFINE_PASS(double)
+DEFINE_PASS(checked)
+
+/*
+*	One pass that decides the type for every edge
+*/
+static long switched_pass(struct bench_edge* edges, int n_edges, union value* values, int type) {
+	long errors = 0;
+	for (int e = 0; e < n_edges; e++) {
+		int error = 0;
+		if (type == VALUE_INT) {
+			error = int_apply(edges[e].op, &values[edges[e].dst], edges[e].operand);
+		} else if (type == VALUE_INT64) {
+			error = int64_apply(edges[e].op, &values[edges[e].dst], edges[e].operand);
+		} else if (type == VALUE_DOUBLE) {
+			error = double_apply(edges[e].op, &values[edges[e].dst], edges[e].operand);
+		} else {
+			error = checked_apply(edges[e].op, &values[edges[e].dst], edges[e].operand);
+		}
+		errors += error != 0;
+	}
+	return errors;
+}
+
+/*
+*	Make the edges, with operands of the type that are never 0 so that every division is done
+*/
+static void make_edges(struct bench_edge* edges, int n_edges, int type) {
+	srand(3360);
+	for (int e = 0; e < n_edges; e++) {
+		edges[e].op = rand() % 5;
+		edges[e].dst = rand() % 10;
+		int operand = rand() % 19 - 9;
+		if (operand == 0) {
+			operand = 1;
+		}
+		if (type == VALUE_DOUBLE) {
+			edges[e].operand.f = operand;
+		} else {
+			edges[e].operand.i = operand;
+		}
+	}
+}
+
+static void report(const char* name, double seconds, long n, long errors, union value* values, int type) {
+	// print a value so the work cannot be thrown away
+	printf("%-18s %8.2f ns/edge %10.1f Medges/s  refused %-9ld p0 = ", name, seconds * 1e9 / n, n / seconds / 1e6, errors);
+	print_value(stdout, type, values[0]);
+	printf("\n");
+}
+
+int main(int argc, char** argv) {
+	int n_edges = argc > 1 ? atoi(argv[1]) : 1 << 20;
+	int passes = argc > 2 ? atoi(argv[2]) : 50;
+	struct bench_edge* edges = (struct bench_edge*)malloc(sizeof(struct bench_edge) * n_edges);
+	long n = (long)n_edges * passes;
+
+	make_edges(edges, n_edges, VALUE_INT);
+	int int_values[10] = {0};
+	double start = now_in_seconds();
+	for (int p = 0; p < passes; p++) {
+		baseline_pass(edges, n_edges, int_values);
+	}
+	double seconds = now_in_seconds() - start;
+	union value shown;
+	shown.i = int_values[0];
+	report("int (untyped)", seconds, n, 0, &shown, VALUE_INT);
+
+	long (*passes_of[])(struct bench_edge*, int, union value*) = {int_pass, int64_pass, double_pass, checked_pass};
+	for (int type = VALUE_INT; type <= VALUE_CHECKED; type++) {
+		make_edges(edges, n_edges, type);
+		union value values[10] = {{0}};
+		long errors = 0;
+		start = now_in_seconds();
+		for (int p = 0; p < passes; p++) {
+			errors += passes_of[type](edges, n_edges, values);
+		}
+		report(value_type_name(type), now_in_seconds() - start, n, errors, values, type);
+
+		union value switched[10] = {{0}};
+		char name[32];
+		snprintf(name, sizeof(name), "%s (switched)", value_type_name(type));
+		errors = 0;
+		start = now_in_seconds();
+		for (int p = 0; p < passes; p++) {
+			errors += switched_pass(edges, n_edges, switched, type);
+		}
+		report(name, now_in_seconds() - start, n, errors, switched, type);
+	}
+	free(edges);
+	return 0;
+}
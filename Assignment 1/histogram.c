@@ -0,0 +1,114 @@
+/*
+*	The latency histogram of the streaming mode. See histogram.h for the layout of the buckets.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "histogram.h"
+
+#define SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HALF_BUCKETS (SUB_BUCKETS / 2)
+
+/*
+*	The bucket of a value. A value of 2048 or more is shifted right until it is between 1024 and 2047, and the
+*	number of shifts picks the group of 1024 buckets it goes in.
+*/
+static int bucket_of(long value) {
+	if (value < SUB_BUCKETS) {
+		return value < 0 ? 0 : (int)value;
+	}
+	int shift = (63 - __builtin_clzl(value)) - (HISTOGRAM_SUB_BITS - 1);
+	return shift * HALF_BUCKETS + (int)(value >> shift);
+}
+
+/*
+*	The largest value that goes in a bucket
+*/
+static long highest_in_bucket(int bucket) {
+	if (bucket < SUB_BUCKETS) {
+		return bucket;
+	}
+	int shift = bucket / HALF_BUCKETS - 1;
+	long sub = bucket - shift * HALF_BUCKETS;
+	return ((sub + 1) << shift) - 1;
+}
+
+/*
+*	Get an empty histogram ready
+*/
+void init_histogram(struct histogram* h) {
+	h->n_counts = bucket_of((1L << HISTOGRAM_MAX_BITS) - 1) + 1;
+	h->counts = (long*)calloc(h->n_counts, sizeof(long));
+	reset_histogram(h);
+}
+
+/*
+*	Count one value
+*/
+void record_value(struct histogram* h, long value) {
+	int bucket = bucket_of(value);
+	if (bucket >= h->n_counts) {
+		bucket = h->n_counts - 1;
+	}
+	h->counts[bucket]++;
+	if (h->total == 0 || value < h->min) {
+		h->min = value;
+	}
+	if (value > h->max) {
+		h->max = value;
+	}
+	h->total++;
+	h->sum += value;
+}
+
+/*
+*	The value below which the given percent of the values are (at the precision of the histogram), or 0 if it is empty
+*/
+long histogram_percentile(struct histogram* h, double percent) {
+	if (h->total == 0) {
+		return 0;
+	}
+	long wanted = (long)(percent / 100 * h->total + 0.5);
+	if (wanted < 1) {
+		wanted = 1;
+	}
+	long seen = 0;
+	for (int b = 0; b < h->n_counts; b++) {
+		seen += h->counts[b];
+		if (seen >= wanted) {
+			// the top of the bucket can be past the largest value that was actually recorded
+			long value = highest_in_bucket(b);
+			return value < h->max ? value : h->max;
+		}
+	}
+	return h->max;
+}
+
+/*
+*	Print the number of values, their mean, p50, p90, p99, p99.9 and their maximum in microseconds on one line
+*/
+void print_histogram(FILE* output, char* name, struct histogram* h) {
+	double mean = h->total > 0 ? h->sum / h->total : 0;
+	fprintf(output, "%s: rows %ld  mean %.1fus  min %.1fus  p50 %.1fus  p90 %.1fus  p99 %.1fus  p999 %.1fus  max %.1fus\n",
+		name, h->total, mean / 1e3, h->min / 1e3, histogram_percentile(h, 50) / 1e3, histogram_percentile(h, 90) / 1e3,
+		histogram_percentile(h, 99) / 1e3, histogram_percentile(h, 99.9) / 1e3, h->max / 1e3);
+}
+
+/*
+*	Empty the histogram, keeping its memory
+*/
+void reset_histogram(struct histogram* h) {
+	memset(h->counts, 0, sizeof(long) * h->n_counts);
+	h->total = 0;
+	h->min = 0;
+	h->max = 0;
+	h->sum = 0;
+}
+
+/*
+*	Free the memory of the histogram
+*/
+void destroy_histogram(struct histogram* h) {
+	free(h->counts);
+}
@@ -0,0 +1,50 @@
+/*
+*	A histogram of latencies in the style of HdrHistogram. Values below 2048 have a bucket each, and above that every
+*	power of two is split into 1024 buckets, so a value is always known to within 0.1% whatever its size. Recording a
+*	value is one shift and one increment, and the memory does not grow with the number of values.
+*
+*	The values are nanoseconds, up to about 18 minutes; anything longer is counted as the longest value there is.
+*/
+#define HISTOGRAM_SUB_BITS 11
+#define HISTOGRAM_MAX_BITS 40
+
+struct histogram {
+	long* counts;
+	int n_counts;
+	long total;
+	long min;
+	long max;
+	double sum;
+};
+
+
+
+/*
+*	Get an empty histogram ready
+*/
+void init_histogram(struct histogram* h);
+
+/*
+*	Count one value
+*/
+void record_value(struct histogram* h, long value);
+
+/*
+*	The value below which the given percent of the values are (at the precision of the histogram), or 0 if it is empty
+*/
+long histogram_percentile(struct histogram* h, double percent);
+
+/*
+*	Print the number of values, their mean, p50, p90, p99, p99.9 and their maximum in microseconds on one line
+*/
+void print_histogram(FILE* output, char* name, struct histogram* h);
+
+/*
+*	Empty the histogram, keeping its memory
+*/
+void reset_histogram(struct histogram* h);
+
+/*
+*	Free the memory of the histogram
+*/
+void destroy_histogram(struct histogram* h);
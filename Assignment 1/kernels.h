@@ -0,0 +1,145 @@
+#include <limits.h>
+
+/*
+*	The operators of the precedence graph for each type of value. Every type has its own add, sub, mul and div,
+*	and DEFINE_APPLY builds the function that applies an operation for one type out of them, so that the type is
+*	picked once (when a worker is told the type of the graph) and never again for each edge.
+*
+*	A kernel returns 0, or KERNEL_DIVISION_BY_ZERO or KERNEL_OVERFLOW if it left the value as it was.
+*	The values must already be of the type, so an int is always in the range of an int.
+*/
+#define KERNEL_DIVISION_BY_ZERO 1
+#define KERNEL_OVERFLOW 2
+
+/*
+*	int wraps around at 32 bits like the int of the original program, without the undefined behaviour of
+*	overflowing a signed int in C
+*/
+static inline int int_add(long long* value, long long operand) {
+	*value = (int)((unsigned int)*value + (unsigned int)operand);
+	return 0;
+}
+
+static inline int int_sub(long long* value, long long operand) {
+	*value = (int)((unsigned int)*value - (unsigned int)operand);
+	return 0;
+}
+
+static inline int int_mul(long long* value, long long operand) {
+	*value = (int)((unsigned int)*value * (unsigned int)operand);
+	return 0;
+}
+
+static inline int int_div(long long* value, long long operand) {
+	if (operand == 0) {
+		return KERNEL_DIVISION_BY_ZERO;
+	}
+	// INT_MIN / -1 does not fit and would stop the process, so it wraps around like the other operations
+	*value = operand == -1 ? (int)(0u - (unsigned int)*value) : (int)*value / (int)operand;
+	return 0;
+}
+
+/*
+*	int64 wraps around at 64 bits
+*/
+static inline int int64_add(long long* value, long long operand) {
+	*value = (long long)((unsigned long long)*value + (unsigned long long)operand);
+	return 0;
+}
+
+static inline int int64_sub(long long* value, long long operand) {
+	*value = (long long)((unsigned long long)*value - (unsigned long long)operand);
+	return 0;
+}
+
+static inline int int64_mul(long long* value, long long operand) {
+	*value = (long long)((unsigned long long)*value * (unsigned long long)operand);
+	return 0;
+}
+
+static inline int int64_div(long long* value, long long operand) {
+	if (operand == 0) {
+		return KERNEL_DIVISION_BY_ZERO;
+	}
+	*value = operand == -1 ? (long long)(0ull - (unsigned long long)*value) : *value / operand;
+	return 0;
+}
+
+/*
+*	double follows IEEE 754, so a division by zero gives an infinity (or NaN) instead of an error
+*/
+static inline int double_add(double* value, double operand) {
+	*value += operand;
+	return 0;
+}
+
+static inline int double_sub(double* value, double operand) {
+	*value -= operand;
+	return 0;
+}
+
+static inline int double_mul(double* value, double operand) {
+	*value *= operand;
+	return 0;
+}
+
+static inline int double_div(double* value, double operand) {
+	*value /= operand;
+	return 0;
+}
+
+/*
+*	checked is a 64 bit integer that refuses to overflow
+*/
+static inline int checked_add(long long* value, long long operand) {
+	return __builtin_add_overflow(*value, operand, value) ? KERNEL_OVERFLOW : 0;
+}
+
+static inline int checked_sub(long long* value, long long operand) {
+	return __builtin_sub_overflow(*value, operand, value) ? KERNEL_OVERFLOW : 0;
+}
+
+static inline int checked_mul(long long* value, long long operand) {
+	return __builtin_mul_overflow(*value, operand, value) ? KERNEL_OVERFLOW : 0;
+}
+
+static inline int checked_div(long long* value, long long operand) {
+	if (operand == 0) {
+		return KERNEL_DIVISION_BY_ZERO;
+	}
+	if (*value == LLONG_MIN && operand == -1) {
+		return KERNEL_OVERFLOW;
+	}
+	*value /= operand;
+	return 0;
+}
+
+/*
+*	The __builtin_*_overflow functions write the wrapped result even when they overflow, so the checked kernels
+*	work on a copy that is only kept if the operation succeeded
+*/
+#define DEFINE_APPLY(name, field) \
+static inline int name##_apply(int op, union value* current, union value operand) { \
+	union value result = *current; \
+	int error = 0; \
+	if (op == OP_ASSIGN) { \
+		result.field = operand.field; \
+	} else if (op == OP_ADD) { \
+		error = name##_add(&result.field, operand.field); \
+	} else if (op == OP_SUB) { \
+		error = name##_sub(&result.field, operand.field); \
+	} else if (op == OP_MUL) { \
+		error = name##_mul(&result.field, operand.field); \
+	} else if (op == OP_DIV) { \
+		error = name##_div(&result.field, operand.field); \
+	} \
+	if (error == 0) { \
+		*current = result; \
+	} \
+	return error; \
+}
+
+DEFINE_APPLY(int, i)
+DEFINE_APPLY(int64, i)
+DEFINE_APPLY(double, f)
+DEFINE_APPLY(checked, i)
@@ -0,0 +1,387 @@
+/*
+*	The runner for a manifest of many small precedence graphs. Every graph of the manifest is a job, and a pool of
+*	threads takes the jobs from one queue. The first time a job comes up, its graph is read and its files are opened;
+*	every time after that, up to SLICE_ROWS of its rows are evaluated before it goes to the back of the queue. So the
+*	graphs are read in parallel, and a job with a few rows never waits behind one with millions.
+*
+*	The graphs are small enough that forking workers for each of them would cost more than evaluating them, so a job is
+*	evaluated by the thread that holds it. The edges are applied in the order of the file with the kernels of the type
+*	of the graph, which gives the same values as the coordinator.
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "values.h"
+#include "precedence_graph.h"
+#include "coordinator.h"
+#include "kernels.h"
+#include "manifest.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+#define SLICE_ROWS 256
+#define LINE_LENGTH 300
+
+/*
+*	One graph of the manifest, with its files and its times. A job is only ever held by one thread at a time.
+*/
+struct job {
+	char* graph_path;
+	char* input_path;
+	char* output_path;
+
+	struct precedence_graph graph;
+	FILE* input;
+	FILE* output;
+	char line[LINE_LENGTH];
+	int started;
+	int has_row;
+	int failed;
+
+	int n_edges;
+	long rows;
+	double queued;
+	double wait_seconds;
+	double load_seconds;
+	double eval_seconds;
+	double finished;
+};
+
+/*
+*	The queue of the jobs waiting for a thread, which is a ring since a job is in it at most once
+*/
+struct runner {
+	struct job* jobs;
+	int n_jobs;
+	int value_type;
+
+	pthread_mutex_t lock;
+	pthread_cond_t changed;
+	int* queue;
+	int head;
+	int n_queued;
+	int n_left;
+	double start;
+};
+
+static double now_in_seconds() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+*	Read the next row of the input of a job, skipping blank lines
+*/
+static int next_row(struct job* job) {
+	while (fgets(job->line, LINE_LENGTH, job->input) != NULL) {
+		if (set_input_values(&job->graph, job->line)) {
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*
+*	For every type of value, this builds the function that evaluates up to max_rows rows of a job and writes their
+*	results. It returns TRUE if the job has more rows.
+*/
+#define DEFINE_EVALUATE(name) \
+static int name##_evaluate(struct job* job, int max_rows) { \
+	struct precedence_graph* graph = &job->graph; \
+	for (int n = 0; n < max_rows && job->has_row; n++) { \
+		for (int v = 0; v < graph->n_internal_var; v++) { \
+			graph->internal_var[v].value.i = 0; \
+		} \
+		for (int e = 0; e < graph->n_edges; e++) { \
+			struct edge* edge = &graph->edges[e]; \
+			union value operand = edge->src_is_input ? graph->input_var[edge->src].value : graph->internal_var[edge->src].value; \
+			int error = name##_apply(edge->op, &graph->internal_var[edge->dst].value, operand); \
+			if (error != 0) { \
+				report_kernel_error(error, graph->value_type, graph->internal_var[edge->dst].value); \
+			} \
+		} \
+		print_internal_var(job->output, graph); \
+		job->rows++; \
+		job->has_row = next_row(job); \
+	} \
+	return job->has_row; \
+}
+
+DEFINE_EVALUATE(int)
+DEFINE_EVALUATE(int64)
+DEFINE_EVALUATE(double)
+DEFINE_EVALUATE(checked)
+
+static int (*evaluators[])(struct job*, int) = {int_evaluate, int64_evaluate, double_evaluate, checked_evaluate};
+
+/*
+*	Read the graph of a job and open its input and output, with the first row of the input in the input variables.
+*	It returns TRUE if the job has a row to evaluate, and FALSE if it is empty or failed.
+*/
+static int start_job(struct job* job, int value_type) {
+	struct precedence_graph* graph = &job->graph;
+	graph->edges = NULL;
+	graph->n_edges = 0;
+	FILE* prec_graph = fopen(job->graph_path, "r");
+	job->input = fopen(job->input_path, "r");
+	job->output = fopen(job->output_path, "w");
+	if (prec_graph == NULL || job->input == NULL || job->output == NULL) {
+		fprintf(stderr, "%s: could not open its graph, input or output: %s\n", job->graph_path, strerror(errno));
+		if (prec_graph != NULL) {
+			fclose(prec_graph);
+		}
+		job->failed = TRUE;
+		return FALSE;
+	}
+
+	char graph_line[LINE_LENGTH];
+	graph->value_type = read_value_type(prec_graph, graph_line, LINE_LENGTH);
+	if (value_type != -1) {
+		graph->value_type = value_type;
+	}
+	if (graph->value_type == -1) {
+		fclose(prec_graph);
+		job->failed = TRUE;
+		return FALSE;
+	}
+	// the first row is read with the names of the input variables, as in main
+	job->has_row = fgets(job->line, LINE_LENGTH, job->input) != NULL;
+	if (!job->has_row) {
+		job->line[0] = '\0';
+	}
+	init_input_var(graph_line, job->line, graph->input_var, &graph->n_input_var, graph->value_type);
+	if (fgets(graph_line, LINE_LENGTH, prec_graph) == NULL) {
+		graph_line[0] = '\0';
+	}
+	init_internal_var(graph_line, graph->internal_var, &graph->n_internal_var);
+	int status = load_edges(prec_graph, graph);
+	fclose(prec_graph);
+	job->n_edges = graph->n_edges;
+	if (status == -1) {
+		fprintf(stderr, "%s: could not read the graph\n", job->graph_path);
+		job->failed = TRUE;
+		return FALSE;
+	}
+	return job->has_row;
+}
+
+static void end_job(struct job* job) {
+	if (job->input != NULL) {
+		fclose(job->input);
+	}
+	if (job->output != NULL && fclose(job->output) != 0) {
+		fprintf(stderr, "%s: could not write %s\n", job->graph_path, job->output_path);
+		job->failed = TRUE;
+	}
+	destroy_edges(&job->graph);
+}
+
+/*
+*	Take the job at the front of the queue, waiting for one if every job left is held by another thread.
+*	It returns -1 once every job is finished.
+*/
+static int take_job(struct runner* r) {
+	pthread_mutex_lock(&r->lock);
+	while (r->n_queued == 0 && r->n_left > 0) {
+		pthread_cond_wait(&r->changed, &r->lock);
+	}
+	int j = -1;
+	if (r->n_queued > 0) {
+		j = r->queue[r->head];
+		r->head = (r->head + 1) % r->n_jobs;
+		r->n_queued--;
+	}
+	pthread_mutex_unlock(&r->lock);
+	return j;
+}
+
+/*
+*	Put a job at the back of the queue, or count it as finished
+*/
+static void give_back_job(struct runner* r, int j, int finished) {
+	pthread_mutex_lock(&r->lock);
+	if (finished) {
+		r->n_left--;
+		pthread_cond_broadcast(&r->changed);
+	} else {
+		r->jobs[j].queued = now_in_seconds();
+		r->queue[(r->head + r->n_queued) % r->n_jobs] = j;
+		r->n_queued++;
+		pthread_cond_signal(&r->changed);
+	}
+	pthread_mutex_unlock(&r->lock);
+}
+
+static void* run_jobs(void* arg) {
+	struct runner* r = (struct runner*)arg;
+	int j;
+	while ((j = take_job(r)) != -1) {
+		struct job* job = &r->jobs[j];
+		double start = now_in_seconds();
+		job->wait_seconds += start - job->queued;
+		int more;
+		if (!job->started) {
+			job->started = TRUE;
+			more = start_job(job, r->value_type);
+			job->load_seconds = now_in_seconds() - start;
+		} else {
+			more = evaluators[job->graph.value_type](job, SLICE_ROWS);
+			job->eval_seconds += now_in_seconds() - start;
+		}
+		if (!more) {
+			end_job(job);
+			job->finished = now_in_seconds() - r->start;
+		}
+		give_back_job(r, j, !more);
+	}
+	return NULL;
+}
+
+/*
+*	Read the jobs of the manifest. It returns the number of jobs, or -1 if the manifest cannot be read.
+*/
+static int read_manifest(char* manifest_path, struct job** jobs) {
+	FILE* manifest = fopen(manifest_path, "r");
+	if (manifest == NULL) {
+		fprintf(stderr, "could not open the manifest %s: %s\n", manifest_path, strerror(errno));
+		return -1;
+	}
+	int capacity = 16;
+	int n_jobs = 0;
+	*jobs = (struct job*)malloc(sizeof(struct job) * capacity);
+	char line[3 * 1024];
+	int line_number = 0;
+	while (fgets(line, sizeof(line), manifest) != NULL) {
+		line_number++;
+		char* save;
+		char* paths[3];
+		int n_paths = 0;
+		for (char* tok = strtok_r(line, " \t\r\n", &save); tok != NULL && n_paths < 3; tok = strtok_r(NULL, " \t\r\n", &save)) {
+			paths[n_paths++] = tok;
+		}
+		if (n_paths == 0 || paths[0][0] == '#') {
+			continue;
+		}
+		if (n_paths < 3) {
+			fprintf(stderr, "%s:%d: a job is a graph, an input and an output\n", manifest_path, line_number);
+			fclose(manifest);
+			return -1;
+		}
+		if (n_jobs == capacity) {
+			capacity *= 2;
+			*jobs = (struct job*)realloc(*jobs, sizeof(struct job) * capacity);
+		}
+		struct job* job = &(*jobs)[n_jobs++];
+		memset(job, 0, sizeof(struct job));
+		job->graph_path = strdup(paths[0]);
+		job->input_path = strdup(paths[1]);
+		job->output_path = strdup(paths[2]);
+	}
+	fclose(manifest);
+	return n_jobs;
+}
+
+/*
+*	Print how long every job took: reading its graph, evaluating its rows, and waiting in the queue, and when it
+*	finished since the start of the run. The total shows how much of the pool the jobs kept busy.
+*/
+static void print_report(struct job* jobs, int n_jobs, int n_threads, double seconds) {
+	long rows = 0;
+	long edges = 0;
+	int failed = 0;
+	double busy = 0;
+	fprintf(stderr, "%-32s %10s %6s %10s %12s %12s %10s %12s\n", "graph", "rows", "edges", "read ms", "evaluate ms", "waiting ms", "done at s", "rows/s");
+	for (int j = 0; j < n_jobs; j++) {
+		struct job* job = &jobs[j];
+		fprintf(stderr, "%-32s %10ld %6d %10.2f %12.2f %12.2f %10.3f %12.0f%s\n", job->graph_path, job->rows, job->n_edges,
+			job->load_seconds * 1e3, job->eval_seconds * 1e3, job->wait_seconds * 1e3, job->finished,
+			job->eval_seconds > 0 ? job->rows / job->eval_seconds : 0.0, job->failed ? "  FAILED" : "");
+		rows += job->rows;
+		edges += job->rows * job->n_edges;
+		failed += job->failed;
+		busy += job->load_seconds + job->eval_seconds;
+	}
+	fprintf(stderr, "jobs: %d  failed: %d  threads: %d  rows: %ld  edges applied: %ld  time: %.3fs  rows per second: %.0f  pool busy: %.1f%%\n",
+		n_jobs, failed, n_threads, rows, edges, seconds, seconds > 0 ? rows / seconds : 0.0,
+		seconds > 0 ? 100 * busy / (seconds * n_threads) : 0.0);
+}
+
+/*
+*	This function evaluates every job of a manifest, a file with one "graph input output" line per precedence graph
+*	(blank lines and lines starting with # are skipped), on a pool of n_threads threads (one per processor if it is
+*	less than 1). value_type is the type of the values of every graph, or -1 to use the value_type line of each graph.
+*	The output of each job is the same as the one of ./main graph input, and a report of how long every job took is
+*	printed to stderr at the end.
+*
+*	It returns 0 if every job succeeded and -1 if the manifest could not be read or a job failed.
+*/
+int run_manifest(char* manifest_path, int n_threads, int value_type) {
+	struct runner r;
+	r.n_jobs = read_manifest(manifest_path, &r.jobs);
+	if (r.n_jobs == -1) {
+		return -1;
+	}
+	if (n_threads < 1) {
+		n_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	}
+	if (n_threads > r.n_jobs) {
+		n_threads = r.n_jobs > 0 ? r.n_jobs : 1;
+	}
+
+	/*
+	*	Every job starts in the queue in the order of the manifest, so the graphs are read first, in parallel
+	*/
+	r.value_type = value_type;
+	r.queue = (int*)malloc(sizeof(int) * (r.n_jobs + 1));
+	r.head = 0;
+	r.n_queued = r.n_jobs;
+	r.n_left = r.n_jobs;
+	pthread_mutex_init(&r.lock, NULL);
+	pthread_cond_init(&r.changed, NULL);
+	r.start = now_in_seconds();
+	for (int j = 0; j < r.n_jobs; j++) {
+		r.queue[j] = j;
+		r.jobs[j].queued = r.start;
+	}
+
+	pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * n_threads);
+	int n_started = 0;
+	for (int t = 0; t < n_threads; t++) {
+		if (pthread_create(&threads[t], NULL, run_jobs, &r) != 0) {
+			fprintf(stderr, "could not start thread %d of the pool\n", t);
+			break;
+		}
+		n_started++;
+	}
+	if (n_started == 0) {
+		// the jobs can still be run without a pool
+		run_jobs(&r);
+	}
+	for (int t = 0; t < n_started; t++) {
+		pthread_join(threads[t], NULL);
+	}
+	print_report(r.jobs, r.n_jobs, n_started > 0 ? n_started : 1, now_in_seconds() - r.start);
+
+	int status = 0;
+	for (int j = 0; j < r.n_jobs; j++) {
+		if (r.jobs[j].failed) {
+			status = -1;
+		}
+		free(r.jobs[j].graph_path);
+		free(r.jobs[j].input_path);
+		free(r.jobs[j].output_path);
+	}
+	pthread_mutex_destroy(&r.lock);
+	pthread_cond_destroy(&r.changed);
+	free(threads);
+	free(r.queue);
+	free(r.jobs);
+	return status;
+}
@@ -0,0 +1,10 @@
+/*
+*	This function evaluates every job of a manifest, a file with one "graph input output" line per precedence graph
+*	(blank lines and lines starting with # are skipped), on a pool of n_threads threads (one per processor if it is
+*	less than 1). value_type is the type of the values of every graph, or -1 to use the value_type line of each graph.
+*	The output of each job is the same as the one of ./main graph input, and a report of how long every job took is
+*	printed to stderr at the end.
+*
+*	It returns 0 if every job succeeded and -1 if the manifest could not be read or a job failed.
+*/
+int run_manifest(char* manifest_path, int n_threads, int value_type);
@@ -0,0 +1,256 @@
+/*
+*	This is the TCP transport for the coordinator. A worker on the other end of a socket runs the same worker_loop as
+*	a worker on the other end of a pair of pipes; the only difference is that one socket carries both directions.
+*/
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "values.h"
+#include "coordinator.h"
+#include "network.h"
+
+/*
+*	Open a socket listening on the port of 127.0.0.1 (or of every address if any_address is set). A port of 0 lets
+*	the system choose, and the port chosen is put back into port. It returns the socket, or -1 on failure.
+*/
+static int listen_on(int* port, int any_address) {
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (fd == -1) {
+		fprintf(stderr, "socket failed: %s\n", strerror(errno));
+		return -1;
+	}
+	int yes = 1;
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(*port);
+	addr.sin_addr.s_addr = any_address ? htonl(INADDR_ANY) : htonl(INADDR_LOOPBACK);
+	if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) == -1 || listen(fd, 4) == -1) {
+		fprintf(stderr, "could not listen on port %d: %s\n", *port, strerror(errno));
+		close(fd);
+		return -1;
+	}
+
+	socklen_t addr_len = sizeof(addr);
+	getsockname(fd, (struct sockaddr*)&addr, &addr_len);
+	*port = ntohs(addr.sin_port);
+	return fd;
+}
+
+/*
+*	The coordinator sends its messages in batches itself, so there is no reason for the socket to hold them back
+*/
+static void set_no_delay(int fd) {
+	int yes = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+}
+
+/*
+*	This function runs a worker that waits for coordinators on a TCP port. It serves one coordinator at a time, and
+*	goes back to waiting once the coordinator is done, so the same workers can be used for run after run.
+*	It only returns if the port cannot be opened.
+*/
+int serve_tcp_worker(int port) {
+	int listen_fd = listen_on(&port, (1 == 1));
+	if (listen_fd == -1) {
+		return -1;
+	}
+	fprintf(stderr, "worker listening on port %d\n", port);
+	while (1 == 1) {
+		int fd = accept(listen_fd, NULL, NULL);
+		if (fd == -1) {
+			if (errno == EINTR) continue;
+			fprintf(stderr, "accept failed: %s\n", strerror(errno));
+			continue;
+		}
+		set_no_delay(fd);
+		worker_loop(fd, fd);
+		close(fd);
+	}
+}
+
+/*
+*	Connect to one worker at host:port. It returns the socket, or -1 on failure.
+*/
+static int connect_to(char* host, char* port) {
+	struct addrinfo hints;
+	struct addrinfo* found;
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_STREAM;
+	int error = getaddrinfo(host, port, &hints, &found);
+	if (error != 0) {
+		fprintf(stderr, "could not find %s: %s\n", host, gai_strerror(error));
+		return -1;
+	}
+
+	int fd = -1;
+	for (struct addrinfo* a = found; a != NULL && fd == -1; a = a->ai_next) {
+		fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+		if (fd != -1 && connect(fd, a->ai_addr, a->ai_addrlen) == -1) {
+			close(fd);
+			fd = -1;
+		}
+	}
+	freeaddrinfo(found);
+	if (fd == -1) {
+		fprintf(stderr, "could not connect to %s:%s\n", host, port);
+		return -1;
+	}
+	set_no_delay(fd);
+	return fd;
+}
+
+/*
+*	This function connects to the workers in addresses, a comma separated list of host:port pairs, and sets up one
+*	channel for each of them. It returns the number of workers, or -1 if one of them cannot be reached.
+*/
+int connect_tcp_workers(char* addresses, struct channel* channels, int max_workers) {
+	char* list = strdup(addresses);
+	char* save;
+	int n_workers = 0;
+	for (char* tok = strtok_r(list, ",", &save); tok != NULL && n_workers < max_workers; tok = strtok_r(NULL, ",", &save)) {
+		char* colon = strrchr(tok, ':');
+		if (colon == NULL) {
+			fprintf(stderr, "worker address is not host:port: %s\n", tok);
+			free(list);
+			return -1;
+		}
+		*colon = '\0';
+		int fd = connect_to(tok, colon + 1);
+		if (fd == -1) {
+			free(list);
+			return -1;
+		}
+		init_channel(&channels[n_workers++], -1, fd, fd);
+	}
+	free(list);
+	return n_workers;
+}
+
+/*
+*	Stop the first n_started local workers, when the others could not be started: they are killed, since some of them
+*	may still be waiting for their connection, and their channels are closed and they are waited for
+*/
+static void stop_local_workers(struct channel* channels, int n_started) {
+	for (int w = 0; w < n_started; w++) {
+		if (channels[w].pid != -1) {
+			kill(channels[w].pid, SIGTERM);
+		}
+	}
+	close_channels(channels, n_started);
+}
+
+/*
+*	This function forks n_workers workers listening on ports of 127.0.0.1 chosen by the system, and connects to
+*	them the same way as to workers on other machines. Each worker reports its port back through a pipe before it
+*	waits for the connection, and leaves once the coordinator is done with it.
+*	It returns 0 on success and -1 on failure.
+*/
+int start_local_tcp_workers(struct channel* channels, int n_workers) {
+	fflush(stdout);
+	for (int w = 0; w < n_workers; w++) {
+		init_channel(&channels[w], -1, -1, -1);
+	}
+	for (int w = 0; w < n_workers; w++) {
+		int port_pipe[2];
+		if (pipe(port_pipe) == -1) {
+			fprintf(stderr, "pipe failed: %s\n", strerror(errno));
+			stop_local_workers(channels, w);
+			return -1;
+		}
+		int pid = fork();
+		if (pid == -1) {
+			fprintf(stderr, "fork failed: %s\n", strerror(errno));
+			close(port_pipe[0]);
+			close(port_pipe[1]);
+			stop_local_workers(channels, w);
+			return -1;
+		}
+		if (!pid) {
+			for (int i = 0; i < w; i++) {
+				close(channels[i].to_worker);
+			}
+			close(port_pipe[0]);
+			int port = 0;
+			int listen_fd = listen_on(&port, (1 == 0));
+			if (write(port_pipe[1], &port, sizeof(port)) != sizeof(port)) {
+				fprintf(stderr, "local worker %d could not report its port\n", w);
+				close(port_pipe[1]);
+				exit(EXIT_FAILURE);
+			}
+			close(port_pipe[1]);
+			if (listen_fd == -1) {
+				exit(EXIT_FAILURE);
+			}
+			int fd = accept(listen_fd, NULL, NULL);
+			close(listen_fd);
+			if (fd != -1) {
+				set_no_delay(fd);
+				worker_loop(fd, fd);
+				close(fd);
+			}
+			exit(EXIT_SUCCESS);
+		}
+		close(port_pipe[1]);
+		int port = -1;
+		ssize_t got = read(port_pipe[0], &port, sizeof(port));
+		close(port_pipe[0]);
+		// the worker is stopped with the others from here on if something goes wrong
+		init_channel(&channels[w], pid, -1, -1);
+		if (got != sizeof(port) || port <= 0) {
+			fprintf(stderr, "local worker %d could not open a port\n", w);
+			stop_local_workers(channels, w + 1);
+			return -1;
+		}
+
+		char port_str[8];
+		sprintf(port_str, "%d", port);
+		int fd = connect_to("127.0.0.1", port_str);
+		if (fd == -1) {
+			stop_local_workers(channels, w + 1);
+			return -1;
+		}
+		channels[w].to_worker = fd;
+		channels[w].from_worker = fd;
+	}
+	return 0;
+}
+
+/*
+*	This function waits on the port (of every address) for one client that sends rows to be evaluated as they come,
+*	and returns the socket of that client, or -1 on failure.
+*/
+int accept_row_stream(int port) {
+	int listen_fd = listen_on(&port, (1 == 1));
+	if (listen_fd == -1) {
+		return -1;
+	}
+	fprintf(stderr, "waiting for rows on port %d\n", port);
+	int fd = -1;
+	while (fd == -1) {
+		fd = accept(listen_fd, NULL, NULL);
+		if (fd == -1 && errno != EINTR) {
+			fprintf(stderr, "accept failed: %s\n", strerror(errno));
+			break;
+		}
+	}
+	close(listen_fd);
+	if (fd != -1) {
+		// every row is answered on its own, so the answers should not wait for more of them
+		set_no_delay(fd);
+	}
+	return fd;
+}
@@ -0,0 +1,27 @@
+struct channel;
+
+/*
+*	This function runs a worker that waits for coordinators on a TCP port. It serves one coordinator at a time, and
+*	goes back to waiting once the coordinator is done, so the same workers can be used for run after run.
+*	It only returns if the port cannot be opened.
+*/
+int serve_tcp_worker(int port);
+
+/*
+*	This function connects to the workers in addresses, a comma separated list of host:port pairs, and sets up one
+*	channel for each of them. It returns the number of workers, or -1 if one of them cannot be reached.
+*/
+int connect_tcp_workers(char* addresses, struct channel* channels, int max_workers);
+
+/*
+*	This function forks n_workers workers listening on ports of 127.0.0.1 chosen by the system, and connects to
+*	them the same way as to workers on other machines. It is the way to try the distributed mode on one machine.
+*	It returns 0 on success and -1 on failure.
+*/
+int start_local_tcp_workers(struct channel* channels, int n_workers);
+
+/*
+*	This function waits on the port (of every address) for one client that sends rows to be evaluated as they come,
+*	and returns the socket of that client, or -1 on failure.
+*/
+int accept_row_stream(int port);
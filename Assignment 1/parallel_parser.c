@@ -0,0 +1,318 @@
+/*
+*	A parser for precedence graphs with millions of edges, where reading the file one line at a time with fgets and
+*	strtok takes longer than evaluating it. The file is mapped into memory and cut into chunks at line boundaries,
+*	and every chunk is tokenized by its own thread into its own edge array. The chunks are then put back together
+*	in the order of the file.
+*
+*	The versions of the sources depend on every line above them, so a thread only counts the writes into each
+*	variable within its own chunk. Once every chunk is done, the counts of the chunks before a chunk are added to
+*	the versions inside it.
+*/
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "values.h"
+#include "precedence_graph.h"
+#include "parallel_parser.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	Files smaller than this are not worth starting a thread for, and are parsed in one chunk
+*/
+#define MIN_CHUNK_SIZE (1 << 16)
+
+/*
+*	The names of the variables are at most two characters, so a name is its own key into a table of every
+*	possible name. The tables are filled before the threads start and only read after, so the threads can look
+*	names up at the same time without a lock.
+*/
+#define NAME_KEYS (1 << 16)
+
+struct name_table {
+	signed char input_of[NAME_KEYS];
+	signed char internal_of[NAME_KEYS];
+};
+
+/*
+*	This is one chunk of the file and everything its thread found in it. n_writes[v] is the number of edges into
+*	variable v in the chunk, and the versions in edges only count the writes inside the chunk until the chunks are
+*	put together.
+*/
+struct parse_chunk {
+	struct name_table* names;
+	const char* start;
+	const char* end;
+
+	struct edge* edges;
+	int n_edges;
+	int capacity;
+	int n_writes[10];
+
+	int saw_write;
+	int failed;
+	char error[128];
+};
+
+static int is_delimiter(char c) {
+	return c == ' ' || c == ',' || c == ';' || c == '(' || c == ')' || c == '\n' || c == '\t' || c == '\r';
+}
+
+/*
+*	The key of a name in the name table, or -1 if the token is too long to be a name
+*/
+static int name_key(const char* tok, int len) {
+	if (len == 1) {
+		return (unsigned char)tok[0] << 8;
+	} else if (len == 2) {
+		return ((unsigned char)tok[0] << 8) | (unsigned char)tok[1];
+	}
+	return -1;
+}
+
+static int lookup(signed char* table, const char* tok, int len) {
+	int key = name_key(tok, len);
+	return key == -1 ? -1 : table[key];
+}
+
+/*
+*	Parse one line of the chunk, which has the same forms as for load_edges. It returns FALSE if parsing has to
+*	stop, either at the write instruction or at an error.
+*/
+static int parse_line(struct parse_chunk* chunk, const char* line, const char* line_end) {
+	const char* tok[4];
+	int tok_len[4];
+	int idx = 0;
+	const char* p = line;
+	while (p < line_end && idx < 4) {
+		while (p < line_end && is_delimiter(*p)) p++;
+		if (p == line_end) break;
+		tok[idx] = p;
+		while (p < line_end && !is_delimiter(*p)) p++;
+		tok_len[idx] = p - tok[idx];
+		idx++;
+	}
+	// skip empty lines
+	if (idx == 0) {
+		return TRUE;
+	}
+	// if the first token is write, the graph is finished
+	if (tok_len[0] == 5 && strncmp(tok[0], "write", 5) == 0) {
+		chunk->saw_write = TRUE;
+		return FALSE;
+	}
+
+	struct edge new_edge;
+	int src;
+	int dst;
+	if (idx == 3) {
+		new_edge.op = OP_ASSIGN;
+		src = 0;
+		dst = 2;
+	} else if (idx == 4) {
+		char op = tok_len[0] == 1 ? tok[0][0] : '\0';
+		if (op == '+') {
+			new_edge.op = OP_ADD;
+		} else if (op == '-') {
+			new_edge.op = OP_SUB;
+		} else if (op == '*') {
+			new_edge.op = OP_MUL;
+		} else if (op == '/') {
+			new_edge.op = OP_DIV;
+		} else {
+			snprintf(chunk->error, sizeof(chunk->error), "unknown operator in precedence graph: %.*s", tok_len[0], tok[0]);
+			chunk->failed = TRUE;
+			return FALSE;
+		}
+		src = 1;
+		dst = 3;
+	} else {
+		snprintf(chunk->error, sizeof(chunk->error), "malformed line in precedence graph");
+		chunk->failed = TRUE;
+		return FALSE;
+	}
+
+	new_edge.dst = lookup(chunk->names->internal_of, tok[dst], tok_len[dst]);
+	new_edge.src = lookup(chunk->names->input_of, tok[src], tok_len[src]);
+	new_edge.src_is_input = (new_edge.src != -1);
+	if (!new_edge.src_is_input) {
+		new_edge.src = lookup(chunk->names->internal_of, tok[src], tok_len[src]);
+	}
+	if (new_edge.dst == -1 || new_edge.src == -1) {
+		snprintf(chunk->error, sizeof(chunk->error), "undeclared variable in precedence graph: %.*s -> %.*s",
+			tok_len[src], tok[src], tok_len[dst], tok[dst]);
+		chunk->failed = TRUE;
+		return FALSE;
+	}
+	new_edge.src_version = new_edge.src_is_input ? 0 : chunk->n_writes[new_edge.src];
+	chunk->n_writes[new_edge.dst]++;
+
+	if (chunk->n_edges == chunk->capacity) {
+		chunk->capacity = chunk->capacity * 2;
+		chunk->edges = (struct edge*)realloc(chunk->edges, sizeof(struct edge) * chunk->capacity);
+	}
+	chunk->edges[chunk->n_edges++] = new_edge;
+	return TRUE;
+}
+
+/*
+*	This is what each thread runs: parse every line of its chunk, stopping early at the write instruction or an error
+*/
+static void* parse_chunk(void* arg) {
+	struct parse_chunk* chunk = (struct parse_chunk*)arg;
+	const char* line = chunk->start;
+	while (line < chunk->end) {
+		const char* line_end = memchr(line, '\n', chunk->end - line);
+		if (line_end == NULL) {
+			line_end = chunk->end;
+		}
+		if (!parse_line(chunk, line, line_end)) {
+			break;
+		}
+		line = line_end + 1;
+	}
+	return NULL;
+}
+
+/*
+*	Find the start of the line after position p, or end if there is none
+*/
+static const char* next_line(const char* p, const char* end) {
+	const char* newline = memchr(p, '\n', end - p);
+	return newline == NULL ? end : newline + 1;
+}
+
+/*
+*	This function reads the edges of the precedence graph like load_edges, starting at the current position of
+*	prec_graph, but it maps the file into memory and splits it into n_threads chunks at line boundaries that are
+*	parsed at the same time. The edges come out in the order of the file, so the edges into the same variable keep
+*	their order, and the versions of the sources are the same as load_edges gives.
+*
+*	A file that cannot be mapped (such as a pipe) is read with load_edges instead.
+*	It returns 0 on success and -1 if a line is malformed or refers to a variable that was never declared.
+*/
+int load_edges_parallel(FILE* prec_graph, struct precedence_graph* graph, int n_threads) {
+	long offset = ftell(prec_graph);
+	struct stat st;
+	if (offset == -1 || fstat(fileno(prec_graph), &st) == -1 || !S_ISREG(st.st_mode) || st.st_size <= offset) {
+		return load_edges(prec_graph, graph);
+	}
+	char* file = (char*)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(prec_graph), 0);
+	if (file == MAP_FAILED) {
+		return load_edges(prec_graph, graph);
+	}
+	madvise(file, st.st_size, MADV_SEQUENTIAL);
+	const char* start = file + offset;
+	const char* end = file + st.st_size;
+
+	struct name_table* names = (struct name_table*)malloc(sizeof(struct name_table));
+	memset(names, -1, sizeof(struct name_table));
+	// the input variables come first, so fill the internal variables first and let the input ones win a clash
+	for (int i = 0; i < graph->n_internal_var; i++) {
+		int key = name_key(graph->internal_var[i].name, strlen(graph->internal_var[i].name));
+		if (key != -1) names->internal_of[key] = i;
+	}
+	for (int i = 0; i < graph->n_input_var; i++) {
+		int key = name_key(graph->input_var[i].name, strlen(graph->input_var[i].name));
+		if (key != -1) names->input_of[key] = i;
+	}
+
+	/*
+	*	Cut the file into chunks that end at the end of a line
+	*/
+	if (n_threads < 1) {
+		n_threads = 1;
+	}
+	if ((end - start) / n_threads < MIN_CHUNK_SIZE) {
+		n_threads = (end - start) / MIN_CHUNK_SIZE + 1;
+	}
+	struct parse_chunk* chunks = (struct parse_chunk*)calloc(n_threads, sizeof(struct parse_chunk));
+	const char* chunk_start = start;
+	for (int c = 0; c < n_threads; c++) {
+		const char* chunk_end = c == n_threads - 1 ? end : next_line(start + (end - start) / n_threads * (c + 1), end);
+		if (chunk_end < chunk_start) {
+			chunk_end = chunk_start;
+		}
+		chunks[c].names = names;
+		chunks[c].start = chunk_start;
+		chunks[c].end = chunk_end;
+		chunks[c].capacity = 16 + (chunk_end - chunk_start) / 12;
+		chunks[c].edges = (struct edge*)malloc(sizeof(struct edge) * chunks[c].capacity);
+		chunk_start = chunk_end;
+	}
+
+	/*
+	*	Parse the chunks, the first one on this thread
+	*/
+	pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * n_threads);
+	int* started = (int*)calloc(n_threads, sizeof(int));
+	for (int c = 1; c < n_threads; c++) {
+		started[c] = pthread_create(&threads[c], NULL, parse_chunk, &chunks[c]) == 0;
+		if (!started[c]) {
+			parse_chunk(&chunks[c]);
+		}
+	}
+	parse_chunk(&chunks[0]);
+	for (int c = 1; c < n_threads; c++) {
+		if (started[c]) {
+			pthread_join(threads[c], NULL);
+		}
+	}
+
+	/*
+	*	Put the chunks together in order, up to the chunk with the write instruction. An error in a chunk after it
+	*	does not count, since load_edges would never have read that far.
+	*/
+	int status = 0;
+	int n_used = 0;
+	int n_edges = 0;
+	for (int c = 0; c < n_threads; c++) {
+		n_used++;
+		n_edges += chunks[c].n_edges;
+		if (chunks[c].failed) {
+			fprintf(stderr, "%s\n", chunks[c].error);
+			status = -1;
+			break;
+		}
+		if (chunks[c].saw_write) {
+			break;
+		}
+	}
+
+	graph->n_edges = 0;
+	graph->edges = (struct edge*)malloc(sizeof(struct edge) * (n_edges + 1));
+	int n_writes[10];
+	for (int i = 0; i < 10; i++) {
+		n_writes[i] = 0;
+	}
+	for (int c = 0; c < n_used && status == 0; c++) {
+		struct edge* out = graph->edges + graph->n_edges;
+		for (int e = 0; e < chunks[c].n_edges; e++) {
+			out[e] = chunks[c].edges[e];
+			if (!out[e].src_is_input) {
+				out[e].src_version += n_writes[out[e].src];
+			}
+		}
+		graph->n_edges += chunks[c].n_edges;
+		for (int i = 0; i < 10; i++) {
+			n_writes[i] += chunks[c].n_writes[i];
+		}
+	}
+
+	for (int c = 0; c < n_threads; c++) {
+		free(chunks[c].edges);
+	}
+	free(chunks);
+	free(threads);
+	free(started);
+	free(names);
+	munmap(file, st.st_size);
+	return status;
+}
@@ -0,0 +1,12 @@
+struct precedence_graph;
+
+/*
+*	This function reads the edges of the precedence graph like load_edges, starting at the current position of
+*	prec_graph, but it maps the file into memory and splits it into n_threads chunks at line boundaries that are
+*	parsed at the same time. The edges come out in the order of the file, so the edges into the same variable keep
+*	their order, and the versions of the sources are the same as load_edges gives.
+*
+*	A file that cannot be mapped (such as a pipe) is read with load_edges instead.
+*	It returns 0 on success and -1 if a line is malformed or refers to a variable that was never declared.
+*/
+int load_edges_parallel(FILE* prec_graph, struct precedence_graph* graph, int n_threads);
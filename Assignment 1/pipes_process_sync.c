@@ -1,7 +1,7 @@
 /*
-*	This program is the multiprocess version of the precedence flow. It does not
-*	use semaphores or pipes to different processes, and the sole intention is to provide
-*	the framework on which the multiprocessor program can synchronize off of.
+*	This program is the multiprocess version of the precedence flow. The original version hands the lines
+*	of the precedence graph to one child process at a time and synchronizes with semaphores and pipes. The
+*	coordinator in coordinator.c is the default, and evaluates the graph with every worker pipe open at once.
 */
 #include <unistd.h>
 #include <sys/types.h>
@@ -10,148 +10,37 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-/*
-*   Create a struct that holds in the variable and the current value it possesses.
-*	The assumptions from the input demand that only 3 characters are needed to identify
-*	the variable.
-*/
-struct variable {
-	char name[3];
-	int value;
-};
-
-/*
-*	This method takes in a line from the precedence graph as well as a line from the input 
-*	file and initializes an array of input variables.
-*
-*	This part of the code should not be accessed or manipulated by child processes. The reason
-*	for this is because it uses the strtok function provided by the standard library, and
-*	documentation as well as other online sources warned of its volatility. In cases where
-*	the format for strings are known, use sscanf instead.
-*/
-void init_input_var(char* input_var_line, char* input_line, struct variable* array, int* size) {
-	/*
-	*	Find the number of input variables given input_line.
-	*	This is done by finding the number of commas splitting the
-	*	variables apart and adding 1 to it.
-	*/
-	int n_elements = 1;
-	for (int i = 0; input_var_line[i] != '\0'; i++) {
-		if (input_var_line[i] == ',') n_elements++;
-	}
-	*size = n_elements;
-	
-	int idx = 0;
-	char* tok = strtok(input_line," ,;");
-	while (tok != NULL) {
-		array[idx++].value = atoi(tok);
-		tok = strtok(NULL, " ,");
-	}
-
-	idx = 0;
-	tok = strtok(input_var_line, " ,;");
-	tok = strtok(NULL, " ,;");
-	while (tok != NULL) {
-		strcpy(array[idx++].name, tok);
-		tok = strtok(NULL, " ,;");
-	}
-}
-
-/*
-*	This method takes in a line from the precedence graph file and initializes an 
-*	array of internal variables.
-*
-*	Like in the method above, this part of the code should not be accessed or manipulated 
-*	by child processes, although, it should not be plagued by the same problems.
-*/
-void init_internal_var(char* internal_line, struct variable* array, int* size) {
-	/*
-	*	Find the number of internal variables given internal_line.
-	*	This is done by finding the number of commas splitting the
-	*	variables apart and adding 1 to it.
-	*/
-	int n_elements = 1;
-	for (int i = 0; internal_line[i] != '\0'; i++) {
-		if (internal_line[i] == ',') n_elements++;
-	}
-	*size = n_elements;
-
-	int idx = 0;
-	char* tok = strtok(internal_line," ,;");
-	tok = strtok(NULL, " ,;");
-	while (tok != NULL) {
-		array[idx].value = 0;
-		strcpy(array[idx++].name, tok);
-		tok = strtok(NULL, " ,;");
-	}
-}
+#include <getopt.h>
+#include <time.h>
+#include <errno.h>
+
+#include "values.h"
+#include "precedence_graph.h"
+#include "coordinator.h"
+#include "network.h"
+#include "checkpoint.h"
+#include "trace.h"
+#include "parallel_parser.h"
+#include "profiler.h"
+#include "histogram.h"
+#include "manifest.h"
 
 /*
-*	This program takes in two arguments from terminal given by the user.
-*	
-*	The first argument is the file to precedence graph, and the second argument
-*	is the file to the inputs of the precedence graph.
-*
-*	The program outputs a file which contains the input variable and the 
-*	internal variables after it has gone through the precedence graph.
+*	This is the original evaluation of the precedence graph. The parent reads the rest of the precedence graph
+*	file line by line, and each line is handed to the child process responsible for the internal variable through
+*	a pipe, with the parent waiting on a semaphore until the child is finished with it.
 *
-*	The way this program handles the code is going step by step through the files
-*   to acquire the desired result.
-*
-*   The following assumptions were made about the input provided:
-*       - The internal variables would be enumerated in order from p0, and go to p9 at max,
-*         and so would constitute two characters.
-*       - The input variables would be enumerated in order from a, and go to to j at max, and so
-*         would constitute a single character.
-*       - Every line of the arguments would be partitioned by a semicolon and a newline
-*       - The first two lines are the input and internal variables while the last one is an
-*         instruction to write to output.
-*
-*   These assumptions are necessary to reduce the size of the data structures. A structure that
-*   holds data for the names of the characters would require the variable names to be changed, 
-*   or it would require that in reading the file, the names of the variables would change
-*   to a format more easily accessible.
+*	When it returns in the parent, the values of the internal variables are the results. The child processes
+*	exit inside of this function.
 */
-int main(int argc, char** argv) {
-	/*
-	*   Store the input variables and internal variables in an
-	*	pointer to an array. Store the number of input and internal
-	*	variables in a seperate data type.
-	*/
-	struct variable input_var[10];
-	struct variable internal_var[10];
-	int n_input_var;
-	int n_internal_var;
-
-	/*
-	*	Read the first two lines of the file for the precedence graph
-	*	to determine the number of input variables as well as internal variables.
-	*/
-	FILE* prec_graph = fopen(argv[1], "r");
-	FILE* input = fopen(argv[2], "r");
-
-	/*
-	*   If the files are not provided, exit
-	*/
-	if (prec_graph == NULL || input == NULL) {
-		printf("The files are null\n");
-		exit(EXIT_SUCCESS);
-	}
-	
-	/*
-	*	The lines will not exceed 100 characters, so allocate 100 characters as a buffer.
-	*	Initialize the variable arrays.
-	*/
+void evaluate_with_semaphores(FILE* prec_graph, struct precedence_graph* graph) {
+	struct variable* input_var = graph->input_var;
+	struct variable* internal_var = graph->internal_var;
+	int n_input_var = graph->n_input_var;
+	int n_internal_var = graph->n_internal_var;
 	size_t len = 300;
 	char line[len];
 	char sec_line[len];
-	fgets(line, len, prec_graph);
-	fgets(sec_line, len, input);
-	init_input_var(line, sec_line, input_var, &n_input_var);
-	fclose(input);
-
-	fgets(line, len, prec_graph);
-	init_internal_var(line, internal_var, &n_internal_var);
 
 	/*
 	*	With the input variables and internal variables defined, initialize
@@ -318,7 +207,7 @@ int main(int argc, char** argv) {
 			// read the response from the process
 			char buff[15];
 			read((fd_of_proc[0])[0], buff, 15);
-			sscanf(buff, "%d", &internal_var[i].value);
+			sscanf(buff, "%lld", &internal_var[i].value.i);
 			// printf("recieved value from process %d: %d\n", i, internal_var[i].value);
 			
 		}
@@ -372,7 +261,7 @@ int main(int argc, char** argv) {
 				// this is an instruction to send data to the writing process
 
 				char buff[15];
-				sprintf(buff, "%d", internal_var[child_process_id].value);
+				sprintf(buff, "%d", (int)internal_var[child_process_id].value.i);
 				write((fd_of_proc[writing_process + 1])[1], buff, 15);
 
 				// signal that the child process finished response
@@ -389,7 +278,7 @@ int main(int argc, char** argv) {
 				semop(sid, &op[writing_process + 1], 1);
 			} else if (strcmp(line, "terminate\n") == 0) {
 				char buff[15];
-				sprintf(buff, "%d", internal_var[child_process_id].value);
+				sprintf(buff, "%d", (int)internal_var[child_process_id].value.i);
 				write((fd_of_proc[writing_process + 1])[1], buff, 15);
 				;
 
@@ -424,7 +313,7 @@ int main(int argc, char** argv) {
 					int x;
 					for (int i = 0; i < n_input_var; i++) {
 						if (strcmp(input_var[i].name, ray[0]) == 0) {
-							x = input_var[i].value;
+							x = input_var[i].value.i;
 							internal = (1 == 0);
 							break;
 						}
@@ -483,14 +372,14 @@ int main(int argc, char** argv) {
 						}
 					}
 					// printf("x = %d\n", x);
-					internal_var[child_process_id].value = x;
+					internal_var[child_process_id].value.i = x;
 
 				} else {
 					int x;
 					int internal = (1 == 1);
 					for (int i = 0; i < n_input_var; i++) {
 						if (strcmp(input_var[i].name, ray[1]) == 0) {
-							x = input_var[i].value;
+							x = input_var[i].value.i;
 							internal = (1 == 0);
 							break;
 						}
@@ -550,13 +439,13 @@ int main(int argc, char** argv) {
 					}
 
 					if (strcmp("+", ray[0]) == 0) {
-						internal_var[child_process_id].value += x;
+						internal_var[child_process_id].value.i = (int)internal_var[child_process_id].value.i + x;
 					} else if (strcmp("-", ray[0]) == 0) {
-						internal_var[child_process_id].value -= x;
+						internal_var[child_process_id].value.i = (int)internal_var[child_process_id].value.i - x;
 					} else if (strcmp("*", ray[0]) == 0) {
-						internal_var[child_process_id].value *= x;
+						internal_var[child_process_id].value.i = (int)internal_var[child_process_id].value.i * x;
 					} else if (strcmp("/", ray[0]) == 0) {
-						internal_var[child_process_id].value /= x;
+						internal_var[child_process_id].value.i = (int)internal_var[child_process_id].value.i / x;
 					}
 				}
 			}
@@ -574,7 +463,6 @@ int main(int argc, char** argv) {
 		}
 		
 	}
-	fclose(prec_graph);
 
 	for (int i = 0; i < 10+1; i++) {
 		close((fd_of_proc[i])[1]);
@@ -585,10 +473,537 @@ int main(int argc, char** argv) {
 	}
 
 	semctl(sid, 0, IPC_RMID, 0);
+}
 
-	for (int i = 0; i < n_internal_var; i++) {
-		printf("%s -> %d\n", internal_var[i].name, internal_var[i].value);
+/*
+*	Read the next row of the input file into the input variables, skipping blank lines.
+*	It returns TRUE if there was another row, and FALSE at the end of the file.
+*/
+int read_next_row(FILE* input, struct precedence_graph* graph, char* line, size_t len) {
+	while (fgets(line, len, input) != NULL) {
+		if (set_input_values(graph, line)) {
+			return (1 == 1);
+		}
+	}
+	return (1 == 0);
+}
+
+/*
+*	Get the time in seconds, for the statistics of the coordinator
+*/
+double now_in_seconds() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+*	Evaluate the rows of a stream one at a time as they come in, the first of which is already in the input variables.
+*	The results of every row are flushed as soon as they are written, and the time from reading a row to that flush is
+*	kept in a histogram. The histogram of the rows since the last report is printed to stderr every report_every
+*	seconds (when a row comes in), and the one of all of the rows at the end.
+*/
+int stream_rows(struct coordinator* co, struct precedence_graph* graph, FILE* input, FILE* output, char* line, size_t len, double report_every) {
+	struct histogram recent;
+	struct histogram all;
+	init_histogram(&recent);
+	init_histogram(&all);
+	double last_report = now_in_seconds();
+	double row_start = last_report;
+	int status = 0;
+	int more_rows = (1 == 1);
+	while (more_rows && status == 0) {
+		status = coordinator_evaluate_row(co);
+		if (status == 0) {
+			print_internal_var(output, graph);
+			fflush(output);
+			long latency = (long)((now_in_seconds() - row_start) * 1e9);
+			record_value(&recent, latency);
+			record_value(&all, latency);
+		}
+		double now = now_in_seconds();
+		if (report_every > 0 && now - last_report >= report_every && recent.total > 0) {
+			print_histogram(stderr, "last rows", &recent);
+			reset_histogram(&recent);
+			last_report = now;
+		}
+		if (status == 0) {
+			more_rows = read_next_row(input, graph, line, len);
+			row_start = now_in_seconds();
+		}
+	}
+	print_histogram(stderr, "all rows", &all);
+	destroy_histogram(&recent);
+	destroy_histogram(&all);
+	return status;
+}
+
+/*
+*	Connect to the workers, over TCP if addresses were given or local TCP workers were asked for, and over pipes
+*	otherwise. n_workers is the number of pipe workers to start, and is set to the number of workers connected.
+*	It returns the channels, or NULL on failure.
+*/
+struct channel* start_workers(char* worker_addresses, int n_local_tcp, int* n_workers) {
+	struct channel* channels;
+	int status;
+	if (worker_addresses != NULL) {
+		int max_workers = 1;
+		for (int i = 0; worker_addresses[i] != '\0'; i++) {
+			if (worker_addresses[i] == ',') max_workers++;
+		}
+		channels = (struct channel*)malloc(sizeof(struct channel) * max_workers);
+		*n_workers = connect_tcp_workers(worker_addresses, channels, max_workers);
+		status = *n_workers > 0 ? 0 : -1;
+	} else if (n_local_tcp > 0) {
+		*n_workers = n_local_tcp;
+		channels = (struct channel*)malloc(sizeof(struct channel) * *n_workers);
+		status = start_local_tcp_workers(channels, *n_workers);
+	} else {
+		channels = (struct channel*)malloc(sizeof(struct channel) * *n_workers);
+		status = start_pipe_workers(channels, *n_workers);
+	}
+	if (status == -1) {
+		free(channels);
+		return NULL;
+	}
+	return channels;
+}
+
+/*
+*	Replay a recorded trace against the workers, which have to be as many as the trace was recorded with.
+*	The replay can itself be recorded, so the two traces can be compared message by message.
+*/
+int replay(char* replay_path, int timed, char* worker_addresses, int n_local_tcp, char* trace_path) {
+	int n_workers = trace_workers(replay_path);
+	if (n_workers < 1) {
+		return -1;
+	}
+	if (n_local_tcp > 0) {
+		n_local_tcp = n_workers;
+	}
+	int n_connected = n_workers;
+	struct channel* channels = start_workers(worker_addresses, n_local_tcp, &n_connected);
+	if (channels == NULL) {
+		return -1;
+	}
+	struct trace_writer trace;
+	if (trace_path != NULL) {
+		if (open_trace(&trace, trace_path, n_connected) == -1) {
+			return -1;
+		}
+		record_channels(channels, n_connected, &trace);
+	}
+	int status = replay_trace(replay_path, channels, n_connected, timed);
+	close_channels(channels, n_connected);
+	if (trace_path != NULL) {
+		close_trace(&trace);
+	}
+	free(channels);
+	return status;
+}
+
+/*
+*	This program takes in two arguments from terminal given by the user.
+*	
+*	The first argument is the file to precedence graph, and the second argument
+*	is the file to the inputs of the precedence graph. Every line of the input file
+*	is a row of values for the input variables, and the graph is evaluated for each of them.
+*
+*	The program outputs a file which contains the input variable and the 
+*	internal variables after it has gone through the precedence graph.
+*
+*	The options are:
+*		-b, --backend <backend>		either "epoll" (the coordinator, the default) or "sem" (the original semaphore
+*									handoff, which only evaluates the first row)
+*		-w, --workers <workers>		the number of worker processes for the coordinator (default: one per internal variable)
+*		-c, --connect <addresses>	use the workers listening at the comma separated host:port addresses over TCP
+*		-L, --local-workers <n>		fork that many workers listening on 127.0.0.1 and use them over TCP
+*		-W, --worker <port>			run as a TCP worker on the port instead of evaluating a graph
+*		-s, --stats					print the bytes sent to the workers per row and the rows per second to stderr
+*		-o, --output <file>			write the results to the file instead of the terminal
+*		-k, --checkpoint <file>		write a checkpoint to the file every --checkpoint-every rows (needs --output)
+*		--checkpoint-every <rows>	the number of rows between checkpoints (default: 100000)
+*		--resume					continue from the checkpoint instead of the first row
+*		-t, --type <type>			the type of the values: int (the default), int64, double or checked, in place of the
+*									value_type line of the graph
+*		-P, --parse-threads <n>		the number of threads that read the edges of the graph (default: one per processor)
+*		-T, --trace <file>			record every message between the coordinator and the workers in the file
+*		--replay <file>				send the messages of a recorded trace to the workers instead of evaluating a graph
+*		--replay-timed				keep the times of the recording in the replay instead of going as fast as it can
+*		--profile <prefix>			time every edge, print the critical path of the slowest row to stderr, and write
+*									it to prefix.dot and prefix.json (a Chrome trace)
+*		--stream <source>			evaluate the rows as they come from the source, which is - for stdin or a port to
+*									take one client on (answered on the same socket), in place of the input file, and
+*									print the percentiles of the time each row took to stderr
+*		--report-every <seconds>	how often --stream prints the percentiles of the last rows (default: 10, 0 for never)
+*		--manifest <file>			evaluate every "graph input output" line of the file on a pool of -w threads (default:
+*									one per processor) instead of one graph, and print how long each took to stderr
+*
+*	The way this program handles the code is going step by step through the files
+*   to acquire the desired result.
+*
+*   The following assumptions were made about the input provided:
+*       - The internal variables would be enumerated in order from p0, and go to p9 at max,
+*         and so would constitute two characters.
+*       - The input variables would be enumerated in order from a, and go to to j at max, and so
+*         would constitute a single character.
+*       - Every line of the arguments would be partitioned by a semicolon and a newline
+*       - The first two lines are the input and internal variables while the last one is an
+*         instruction to write to output.
+*
+*   These assumptions are necessary to reduce the size of the data structures. A structure that
+*   holds data for the names of the characters would require the variable names to be changed, 
+*   or it would require that in reading the file, the names of the variables would change
+*   to a format more easily accessible.
+*/
+int main(int argc, char** argv) {
+	const char usage[] = "usage: %s [-b epoll|sem] [-w workers] [-c host:port,...] [-L workers] [-P threads] [-t type] [-s]\n"
+		"          [-o output [-k checkpoint [--checkpoint-every rows] [--resume]]] [-T trace]\n"
+		"          [--profile prefix] <precedence_graph_file> <input_file>\n"
+		"       %s --stream -|port [--report-every seconds] [options] <precedence_graph_file>\n"
+		"       %s --manifest file [-w threads] [-t type]\n"
+		"       %s -W port\n"
+		"       %s --replay trace [--replay-timed] [-c host:port,... | -L workers] [-T trace]\n";
+	const struct option long_options[] = {
+		{"backend", required_argument, NULL, 'b'},
+		{"workers", required_argument, NULL, 'w'},
+		{"connect", required_argument, NULL, 'c'},
+		{"local-workers", required_argument, NULL, 'L'},
+		{"worker", required_argument, NULL, 'W'},
+		{"stats", no_argument, NULL, 's'},
+		{"output", required_argument, NULL, 'o'},
+		{"checkpoint", required_argument, NULL, 'k'},
+		{"checkpoint-every", required_argument, NULL, 'e'},
+		{"resume", no_argument, NULL, 'r'},
+		{"parse-threads", required_argument, NULL, 'P'},
+		{"type", required_argument, NULL, 't'},
+		{"trace", required_argument, NULL, 'T'},
+		{"replay", required_argument, NULL, 'p'},
+		{"replay-timed", no_argument, NULL, 'i'},
+		{"profile", required_argument, NULL, 'f'},
+		{"stream", required_argument, NULL, 'S'},
+		{"report-every", required_argument, NULL, 'R'},
+		{"manifest", required_argument, NULL, 'M'},
+		{NULL, 0, NULL, 0}
+	};
+
+	/*
+	*	Read the options before the two files
+	*/
+	int use_semaphores = (1 == 0);
+	int print_stats = (1 == 0);
+	int resume = (1 == 0);
+	int n_workers = 0;
+	int n_local_tcp = 0;
+	long checkpoint_every = 100000;
+	char* worker_addresses = NULL;
+	char* output_path = NULL;
+	char* checkpoint_path = NULL;
+	char* trace_path = NULL;
+	char* replay_path = NULL;
+	char* profile_prefix = NULL;
+	char* stream_source = NULL;
+	double report_every = 10;
+	char* manifest_path = NULL;
+	int replay_timed = (1 == 0);
+	int n_parse_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	int value_type = -1;
+	int opt;
+	while ((opt = getopt_long(argc, argv, "b:w:c:L:W:so:k:T:P:t:", long_options, NULL)) != -1) {
+		if (opt == 'b') {
+			if (strcmp(optarg, "sem") == 0) {
+				use_semaphores = (1 == 1);
+			} else if (strcmp(optarg, "epoll") != 0) {
+				fprintf(stderr, "unknown backend: %s\n", optarg);
+				exit(EXIT_FAILURE);
+			}
+		} else if (opt == 'w') {
+			n_workers = atoi(optarg);
+		} else if (opt == 'c') {
+			worker_addresses = optarg;
+		} else if (opt == 'L') {
+			n_local_tcp = atoi(optarg);
+		} else if (opt == 'W') {
+			serve_tcp_worker(atoi(optarg));
+			exit(EXIT_FAILURE);
+		} else if (opt == 's') {
+			print_stats = (1 == 1);
+		} else if (opt == 'o') {
+			output_path = optarg;
+		} else if (opt == 'k') {
+			checkpoint_path = optarg;
+		} else if (opt == 'e') {
+			checkpoint_every = atol(optarg);
+		} else if (opt == 'r') {
+			resume = (1 == 1);
+		} else if (opt == 'P') {
+			n_parse_threads = atoi(optarg);
+		} else if (opt == 'T') {
+			trace_path = optarg;
+		} else if (opt == 'p') {
+			replay_path = optarg;
+		} else if (opt == 'i') {
+			replay_timed = (1 == 1);
+		} else if (opt == 'f') {
+			profile_prefix = optarg;
+		} else if (opt == 'S') {
+			stream_source = optarg;
+		} else if (opt == 'R') {
+			report_every = atof(optarg);
+		} else if (opt == 'M') {
+			manifest_path = optarg;
+		} else if (opt == 't') {
+			value_type = parse_value_type(optarg);
+			if (value_type == -1) {
+				fprintf(stderr, "unknown type: %s\n", optarg);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			fprintf(stderr, usage, argv[0], argv[0], argv[0], argv[0], argv[0]);
+			exit(EXIT_FAILURE);
+		}
+	}
+	if (replay_path != NULL) {
+		return replay(replay_path, replay_timed, worker_addresses, n_local_tcp, trace_path) == 0 ? 0 : EXIT_FAILURE;
+	}
+	if (manifest_path != NULL) {
+		return run_manifest(manifest_path, n_workers, value_type) == 0 ? 0 : EXIT_FAILURE;
+	}
+	if (argc - optind < (stream_source != NULL ? 1 : 2)) {
+		fprintf(stderr, usage, argv[0], argv[0], argv[0], argv[0], argv[0]);
+		exit(EXIT_FAILURE);
+	}
+	if ((trace_path != NULL || profile_prefix != NULL) && use_semaphores) {
+		fprintf(stderr, "only the coordinator can be traced or profiled\n");
+		exit(EXIT_FAILURE);
+	}
+	if ((checkpoint_path != NULL || resume) && (output_path == NULL || use_semaphores)) {
+		fprintf(stderr, "checkpoints need an output file (-o) and the coordinator\n");
+		exit(EXIT_FAILURE);
 	}
+	if (stream_source != NULL && (use_semaphores || checkpoint_path != NULL)) {
+		fprintf(stderr, "a stream is evaluated by the coordinator, without checkpoints\n");
+		exit(EXIT_FAILURE);
+	}
+	if (resume && checkpoint_path == NULL) {
+		fprintf(stderr, "--resume needs the checkpoint file (-k)\n");
+		exit(EXIT_FAILURE);
+	}
+	if (checkpoint_every < 1) {
+		checkpoint_every = 1;
+	}
+
+	/*
+	*	If the run is resumed, find where the last one left off. Without a checkpoint, it starts from the beginning.
+	*/
+	struct checkpoint resume_from;
+	if (resume && read_checkpoint(checkpoint_path, &resume_from) == -1) {
+		fprintf(stderr, "no checkpoint in %s, starting from the first row\n", checkpoint_path);
+		resume = (1 == 0);
+	}
+
+	/*
+	*   Store the input variables and internal variables in the
+	*	precedence graph, along with the number of each.
+	*/
+	struct precedence_graph graph;
+
+	/*
+	*	Read the first two lines of the file for the precedence graph
+	*	to determine the number of input variables as well as internal variables.
+	*/
+	FILE* prec_graph = fopen(argv[optind], "r");
+	FILE* input = NULL;
+	int stream_fd = -1;
+	if (stream_source == NULL) {
+		input = fopen(argv[optind + 1], "r");
+	} else if (strcmp(stream_source, "-") == 0) {
+		input = stdin;
+	} else {
+		stream_fd = accept_row_stream(atoi(stream_source));
+		if (stream_fd == -1) {
+			exit(EXIT_FAILURE);
+		}
+		input = fdopen(stream_fd, "r");
+	}
+
+	/*
+	*   If the files are not provided, exit
+	*/
+	if (prec_graph == NULL || input == NULL) {
+		printf("The files are null\n");
+		exit(EXIT_SUCCESS);
+	}
+
+	/*
+	*	When resuming, anything in the output past the checkpoint is from rows that were not finished, so cut it off
+	*/
+	FILE* output = stdout;
+	if (output_path != NULL) {
+		output = fopen(output_path, resume ? "r+" : "w");
+		if (output == NULL) {
+			fprintf(stderr, "could not open the output %s: %s\n", output_path, strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+		if (resume) {
+			if (ftruncate(fileno(output), resume_from.output_offset) == -1) {
+				fprintf(stderr, "could not cut the output back to the checkpoint: %s\n", strerror(errno));
+				exit(EXIT_FAILURE);
+			}
+			fseek(output, resume_from.output_offset, SEEK_SET);
+		}
+	} else if (stream_fd != -1) {
+		output = fdopen(dup(stream_fd), "w");
+	}
+	
+	/*
+	*	The lines will not exceed 100 characters, so allocate 100 characters as a buffer.
+	*	Initialize the variable arrays.
+	*/
+	size_t len = 300;
+	char line[len];
+	char sec_line[len];
+	graph.value_type = read_value_type(prec_graph, line, len);
+	if (value_type != -1) {
+		graph.value_type = value_type;
+	}
+	if (graph.value_type == -1) {
+		exit(EXIT_FAILURE);
+	}
+	if (use_semaphores && graph.value_type != VALUE_INT) {
+		fprintf(stderr, "the semaphore version only has int values\n");
+		exit(EXIT_FAILURE);
+	}
+	fgets(sec_line, len, input);
+	init_input_var(line, sec_line, graph.input_var, &graph.n_input_var, graph.value_type);
+
+	fgets(line, len, prec_graph);
+	init_internal_var(line, graph.internal_var, &graph.n_internal_var);
+
+	if (use_semaphores) {
+		evaluate_with_semaphores(prec_graph, &graph);
+		fclose(prec_graph);
+		fclose(input);
+		print_internal_var(output, &graph);
+		if (output != stdout) {
+			fclose(output);
+		}
+		return 0;
+	}
+
+	/*
+	*	The coordinator needs every edge up front, so read the rest of the graph before starting the workers
+	*/
+	double parse_start = now_in_seconds();
+	int status = load_edges_parallel(prec_graph, &graph, n_parse_threads);
+	fclose(prec_graph);
+	if (status == -1) {
+		exit(EXIT_FAILURE);
+	}
+	if (print_stats) {
+		fprintf(stderr, "parsed %d edges in %.3fs with up to %d threads\n", graph.n_edges, now_in_seconds() - parse_start, n_parse_threads);
+	}
+
+	if (n_workers < 1 || n_workers > graph.n_internal_var) {
+		n_workers = graph.n_internal_var;
+	}
+	struct channel* channels = start_workers(worker_addresses, n_local_tcp, &n_workers);
+	if (channels == NULL) {
+		exit(EXIT_FAILURE);
+	}
+
+	/*
+	*	Record the messages of the run if a trace was asked for
+	*/
+	struct trace_writer trace;
+	if (trace_path != NULL) {
+		if (open_trace(&trace, trace_path, n_workers) == -1) {
+			exit(EXIT_FAILURE);
+		}
+		record_channels(channels, n_workers, &trace);
+	}
+
+	/*
+	*	The checkpoints are written by their own thread, so the loop below only flushes the output and hands over
+	*	the offsets every checkpoint_every rows
+	*/
+	struct checkpointer cp;
+	if (checkpoint_path != NULL && start_checkpointer(&cp, checkpoint_path, fileno(output)) == -1) {
+		exit(EXIT_FAILURE);
+	}
+
+	/*
+	*	Evaluate the graph for every row of the input file. The first row was already read with the names of
+	*	the input variables, and if the run is resumed, the rows before the checkpoint are skipped.
+	*/
+	struct coordinator co;
+	if (coordinator_start(&co, &graph, channels, n_workers) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	struct profile profile;
+	if (profile_prefix != NULL) {
+		start_profile(&profile, &graph, n_workers);
+		if (coordinator_profile(&co, &profile) == -1) {
+			exit(EXIT_FAILURE);
+		}
+	}
+	double start = now_in_seconds();
+	long rows = 0;
+	int more_rows = (1 == 1);
+	if (resume) {
+		rows = resume_from.rows;
+		fseek(input, resume_from.input_offset, SEEK_SET);
+		more_rows = read_next_row(input, &graph, sec_line, len);
+	}
+	if (stream_source != NULL) {
+		status = stream_rows(&co, &graph, input, output, sec_line, len, report_every);
+		more_rows = (1 == 0);
+	}
+	while (more_rows && status == 0) {
+		status = coordinator_evaluate_row(&co);
+		if (status == 0) {
+			print_internal_var(output, &graph);
+			rows++;
+			if (checkpoint_path != NULL && rows % checkpoint_every == 0) {
+				fflush(output);
+				struct checkpoint ckpt = {rows, ftell(input), ftell(output)};
+				post_checkpoint(&cp, &ckpt);
+			}
+		}
+		more_rows = read_next_row(input, &graph, sec_line, len);
+	}
+	if (print_stats) {
+		coordinator_print_stats(&co, now_in_seconds() - start);
+	}
+	if (profile_prefix != NULL) {
+		if (write_profile(&profile, profile_prefix) == -1) {
+			status = -1;
+		}
+		destroy_profile(&profile);
+	}
+
+	/*
+	*	A run that finished checkpoints the end of the input, so resuming it does nothing. This has to happen before the
+	*	workers leave, since a forked worker that exits moves the offset of the input file it shares with this process.
+	*/
+	fflush(output);
+	if (checkpoint_path != NULL) {
+		if (status == 0) {
+			struct checkpoint ckpt = {rows, ftell(input), ftell(output)};
+			post_checkpoint(&cp, &ckpt);
+		}
+		stop_checkpointer(&cp);
+	}
+	coordinator_finish(&co);
+	if (trace_path != NULL) {
+		close_trace(&trace);
+	}
+	if (output != stdout) {
+		fclose(output);
+	}
+	fclose(input);
+	destroy_edges(&graph);
+	free(channels);
 
-	return 0;
+	return status == 0 ? 0 : EXIT_FAILURE;
 }
@@ -0,0 +1,248 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "values.h"
+#include "precedence_graph.h"
+
+/*
+*	This function reads the first line of the precedence graph into line. If it is a "value_type <type>;" line,
+*	it returns the type and reads the line after it (the input_var line) into line instead. Otherwise the graph
+*	is of ints. It returns -1 if the type is unknown.
+*/
+int read_value_type(FILE* prec_graph, char* line, size_t len) {
+	if (fgets(line, len, prec_graph) == NULL) {
+		line[0] = '\0';
+		return VALUE_INT;
+	}
+	if (strncmp(line, "value_type", 10) != 0) {
+		return VALUE_INT;
+	}
+	char* save;
+	char* name = strtok_r(line + 10, " ;\t\r\n", &save);
+	int type = name == NULL ? -1 : parse_value_type(name);
+	if (type == -1) {
+		fprintf(stderr, "unknown value_type in precedence graph: %s\n", name == NULL ? "" : name);
+	}
+	if (fgets(line, len, prec_graph) == NULL) {
+		line[0] = '\0';
+	}
+	return type;
+}
+
+/*
+*	This method takes in a line from the precedence graph as well as a line from the input
+*	file and initializes an array of input variables, with values of the given type.
+*
+*	This part of the code should not be accessed or manipulated by child processes. The reason
+*	for this is because it uses the strtok function provided by the standard library, and
+*	documentation as well as other online sources warned of its volatility. In cases where
+*	the format for strings are known, use sscanf instead.
+*
+*	It now uses strtok_r, which keeps its place in save instead of in the library, so the graphs of a manifest
+*	can be read by several threads at once.
+*/
+void init_input_var(char* input_var_line, char* input_line, struct variable* array, int* size, int value_type) {
+	/*
+	*	Find the number of input variables given input_line.
+	*	This is done by finding the number of commas splitting the
+	*	variables apart and adding 1 to it.
+	*/
+	int n_elements = 1;
+	for (int i = 0; input_var_line[i] != '\0'; i++) {
+		if (input_var_line[i] == ',') n_elements++;
+	}
+	*size = n_elements;
+
+	int idx = 0;
+	char* save;
+	char* tok = strtok_r(input_line, " ,;", &save);
+	while (tok != NULL) {
+		array[idx++].value = parse_value(value_type, tok);
+		tok = strtok_r(NULL, " ,", &save);
+	}
+
+	// the newline is a delimiter too, otherwise it is read as one more variable
+	idx = 0;
+	tok = strtok_r(input_var_line, " ,;\r\n", &save);
+	tok = strtok_r(NULL, " ,;\r\n", &save);
+	while (tok != NULL && idx < n_elements) {
+		strcpy(array[idx++].name, tok);
+		tok = strtok_r(NULL, " ,;\r\n", &save);
+	}
+}
+
+/*
+*	This function reads the values of the input variables from another row of the input file. Variables without
+*	a value in the row are set to 0. It returns TRUE if the line had values in it, and FALSE if it was blank.
+*/
+int set_input_values(struct precedence_graph* graph, char* input_line) {
+	int idx = 0;
+	char* save;
+	char* tok = strtok_r(input_line, " ,;\r\n", &save);
+	if (tok == NULL) {
+		return (1 == 0);
+	}
+	while (tok != NULL && idx < graph->n_input_var) {
+		graph->input_var[idx++].value = parse_value(graph->value_type, tok);
+		tok = strtok_r(NULL, " ,;\r\n", &save);
+	}
+	while (idx < graph->n_input_var) {
+		graph->input_var[idx++].value.i = 0;
+	}
+	return (1 == 1);
+}
+
+/*
+*	This method takes in a line from the precedence graph file and initializes an
+*	array of internal variables.
+*
+*	Like in the method above, this part of the code should not be accessed or manipulated
+*	by child processes, although, it should not be plagued by the same problems.
+*/
+void init_internal_var(char* internal_line, struct variable* array, int* size) {
+	/*
+	*	Find the number of internal variables given internal_line.
+	*	This is done by finding the number of commas splitting the
+	*	variables apart and adding 1 to it.
+	*/
+	int n_elements = 1;
+	for (int i = 0; internal_line[i] != '\0'; i++) {
+		if (internal_line[i] == ',') n_elements++;
+	}
+	*size = n_elements;
+
+	int idx = 0;
+	char* save;
+	char* tok = strtok_r(internal_line, " ,;\r\n", &save);
+	tok = strtok_r(NULL, " ,;\r\n", &save);
+	while (tok != NULL && idx < n_elements) {
+		array[idx].value.i = 0;
+		strcpy(array[idx++].name, tok);
+		tok = strtok_r(NULL, " ,;\r\n", &save);
+	}
+}
+
+/*
+*	Find the index of the variable with the given name, or -1 if there is none
+*/
+static int find_variable(struct variable* array, int size, char* name) {
+	for (int i = 0; i < size; i++) {
+		if (strcmp(array[i].name, name) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+*	This function reads the rest of the precedence graph (every line after the internal_var line up to the write
+*	instruction) into graph->edges. The variables of the graph must already be initialized.
+*
+*	A line is either "src -> dst;" (3 tokens once split, counting "->") or "op src -> dst;" (4 tokens). The version of the
+*	source is recorded so that an edge can be evaluated as soon as the edges before it into its source are done,
+*	rather than waiting for every line above it.
+*
+*	It returns 0 on success and -1 if a line refers to a variable that was never declared.
+*/
+int load_edges(FILE* prec_graph, struct precedence_graph* graph) {
+	const char delimiter[] = " ,;()\n\t\r";
+	size_t len = 300;
+	char line[len];
+
+	int capacity = 16;
+	graph->n_edges = 0;
+	graph->edges = (struct edge*)malloc(sizeof(struct edge) * capacity);
+
+	// the number of edges read so far into each internal variable
+	int n_writes[10];
+	for (int i = 0; i < 10; i++) {
+		n_writes[i] = 0;
+	}
+
+	while (fgets(line, len, prec_graph) != NULL) {
+		char* ray[4];
+		int idx = 0;
+		char* save;
+		char* tok = strtok_r(line, delimiter, &save);
+		// skip empty lines
+		if (tok == NULL) {
+			continue;
+		}
+		// if the first token is write, the graph is finished
+		if (strcmp(tok, "write") == 0) {
+			break;
+		}
+		while (tok != NULL && idx < 4) {
+			ray[idx++] = tok;
+			tok = strtok_r(NULL, delimiter, &save);
+		}
+
+		struct edge new_edge;
+		char* src_name;
+		char* dst_name;
+		if (idx == 3) {
+			new_edge.op = OP_ASSIGN;
+			src_name = ray[0];
+			dst_name = ray[2];
+		} else if (idx == 4) {
+			if (strcmp("+", ray[0]) == 0) {
+				new_edge.op = OP_ADD;
+			} else if (strcmp("-", ray[0]) == 0) {
+				new_edge.op = OP_SUB;
+			} else if (strcmp("*", ray[0]) == 0) {
+				new_edge.op = OP_MUL;
+			} else if (strcmp("/", ray[0]) == 0) {
+				new_edge.op = OP_DIV;
+			} else {
+				fprintf(stderr, "unknown operator in precedence graph: %s\n", ray[0]);
+				return -1;
+			}
+			src_name = ray[1];
+			dst_name = ray[3];
+		} else {
+			fprintf(stderr, "malformed line in precedence graph\n");
+			return -1;
+		}
+
+		new_edge.dst = find_variable(graph->internal_var, graph->n_internal_var, dst_name);
+		new_edge.src = find_variable(graph->input_var, graph->n_input_var, src_name);
+		new_edge.src_is_input = (new_edge.src != -1);
+		if (!new_edge.src_is_input) {
+			new_edge.src = find_variable(graph->internal_var, graph->n_internal_var, src_name);
+		}
+		if (new_edge.dst == -1 || new_edge.src == -1) {
+			fprintf(stderr, "undeclared variable in precedence graph: %s -> %s\n", src_name, dst_name);
+			return -1;
+		}
+		new_edge.src_version = new_edge.src_is_input ? 0 : n_writes[new_edge.src];
+		n_writes[new_edge.dst]++;
+
+		if (graph->n_edges == capacity) {
+			capacity = capacity * 2;
+			graph->edges = (struct edge*)realloc(graph->edges, sizeof(struct edge) * capacity);
+		}
+		graph->edges[graph->n_edges++] = new_edge;
+	}
+	return 0;
+}
+
+/*
+*	This function frees the edge array of the graph
+*/
+void destroy_edges(struct precedence_graph* graph) {
+	free(graph->edges);
+	graph->edges = NULL;
+	graph->n_edges = 0;
+}
+
+/*
+*	Print the values of the internal variables for one row of input
+*/
+void print_internal_var(FILE* output, struct precedence_graph* graph) {
+	for (int i = 0; i < graph->n_internal_var; i++) {
+		fprintf(output, "%s -> ", graph->internal_var[i].name);
+		print_value(output, graph->value_type, graph->internal_var[i].value);
+		fputc('\n', output);
+	}
+}
@@ -0,0 +1,97 @@
+/*
+*   Create a struct that holds in the variable and the current value it possesses.
+*	The assumptions from the input demand that only 3 characters are needed to identify
+*	the variable. The value is of the type of the graph (see values.h).
+*/
+struct variable {
+	char name[3];
+	union value value;
+};
+
+/*
+*	These are the operations that can appear on a line of the precedence graph. A line with
+*	no operator ("x -> p0;") assigns the value of the source to the destination.
+*/
+enum operation {
+	OP_ASSIGN,
+	OP_ADD,
+	OP_SUB,
+	OP_MUL,
+	OP_DIV
+};
+
+/*
+*	An edge is a single line of the precedence graph, already resolved to variable indices.
+*
+*	If src_is_input is set, src indexes the input variables, otherwise it indexes the internal
+*	variables. src_version is the number of edges into src that appear before this edge in the
+*	file, so it is the "version" of src this edge has to read to behave like the file is executed
+*	top to bottom.
+*/
+struct edge {
+	int op;
+	int src;
+	int src_is_input;
+	int src_version;
+	int dst;
+};
+
+/*
+*	The whole precedence graph, held in memory so that the coordinator can see every edge at once
+*	instead of reading the file one line per dispatch.
+*/
+struct precedence_graph {
+	int value_type;
+	struct variable input_var[10];
+	struct variable internal_var[10];
+	int n_input_var;
+	int n_internal_var;
+
+	struct edge* edges;
+	int n_edges;
+};
+
+
+
+/*
+*	This function reads the first line of the precedence graph into line. If it is a "value_type <type>;" line,
+*	it returns the type and reads the line after it (the input_var line) into line instead. Otherwise the graph
+*	is of ints. It returns -1 if the type is unknown.
+*/
+int read_value_type(FILE* prec_graph, char* line, size_t len);
+
+/*
+*	This method takes in a line from the precedence graph as well as a line from the input
+*	file and initializes an array of input variables, with values of the given type.
+*/
+void init_input_var(char* input_var_line, char* input_line, struct variable* array, int* size, int value_type);
+
+/*
+*	This function reads the values of the input variables from another row of the input file.
+*	It returns TRUE if the line had values in it, and FALSE if it was blank.
+*/
+int set_input_values(struct precedence_graph* graph, char* input_line);
+
+/*
+*	This method takes in a line from the precedence graph file and initializes an
+*	array of internal variables.
+*/
+void init_internal_var(char* internal_line, struct variable* array, int* size);
+
+/*
+*	This function reads the rest of the precedence graph (every line after the internal_var line up to the write
+*	instruction) into graph->edges. The variables of the graph must already be initialized.
+*
+*	It returns 0 on success and -1 if a line refers to a variable that was never declared.
+*/
+int load_edges(FILE* prec_graph, struct precedence_graph* graph);
+
+/*
+*	This function frees the edge array of the graph
+*/
+void destroy_edges(struct precedence_graph* graph);
+
+/*
+*	Print the values of the internal variables for one row of input
+*/
+void print_internal_var(FILE* output, struct precedence_graph* graph);
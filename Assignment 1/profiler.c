@@ -0,0 +1,373 @@
+/*
+*	The profiler of the coordinator. The workers time every edge they apply on their own clock and send the times
+*	back in a TIMING message after the RESULT, and the coordinator adds when it sent the edge and when the result came
+*	back. The critical path of a row is found by starting from the last result and going back, every time, to the
+*	edge it waited on that finished last: either the edge before it into the same variable (which the worker has to
+*	finish first) or the edge that wrote the value it reads (which the coordinator has to have the result of).
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "values.h"
+#include "precedence_graph.h"
+#include "profiler.h"
+
+/*
+*	The time on the clock the profile uses
+*/
+long profile_now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+static void init_row_times(struct row_times* row, int n_edges) {
+	row->start = 0;
+	row->end = 0;
+	row->sent = (long*)calloc(n_edges + 1, sizeof(long));
+	row->applied = (long*)calloc(n_edges + 1, sizeof(long));
+	row->apply_ns = (int*)calloc(n_edges + 1, sizeof(int));
+	row->done = (long*)calloc(n_edges + 1, sizeof(long));
+}
+
+static void free_row_times(struct row_times* row) {
+	free(row->sent);
+	free(row->applied);
+	free(row->apply_ns);
+	free(row->done);
+}
+
+/*
+*	Get a profile ready for the graph, evaluated by n_workers workers
+*/
+void start_profile(struct profile* p, struct precedence_graph* graph, int n_workers) {
+	int n_edges = graph->n_edges;
+	p->graph = graph;
+	p->n_workers = n_workers;
+	p->rows = 0;
+	p->slowest_row = -1;
+	p->n_unstamped = 0;
+	p->unstamped = (int*)malloc(sizeof(int) * (n_edges + 1));
+	p->total_latency = (double*)calloc(n_edges + 1, sizeof(double));
+	p->total_apply = (double*)calloc(n_edges + 1, sizeof(double));
+	init_row_times(&p->row, n_edges);
+	init_row_times(&p->slowest, n_edges);
+
+	/*
+	*	Find what every edge waits on. The edges into variable v are in the order of the file, so the version
+	*	of v an edge reads is written by the edge that was the (version)th one into v.
+	*/
+	p->prev_into = (int*)malloc(sizeof(int) * (n_edges + 1));
+	p->producer = (int*)malloc(sizeof(int) * (n_edges + 1));
+	int n_var = graph->n_internal_var;
+	int* last_into = (int*)malloc(sizeof(int) * (n_var + 1));
+	int* queue_start = (int*)calloc(n_var + 2, sizeof(int));
+	int* queue = (int*)malloc(sizeof(int) * (n_edges + 1));
+	for (int v = 0; v < n_var; v++) {
+		last_into[v] = -1;
+	}
+	for (int e = 0; e < n_edges; e++) {
+		queue_start[graph->edges[e].dst + 1]++;
+	}
+	for (int v = 0; v < n_var; v++) {
+		queue_start[v + 1] += queue_start[v];
+	}
+	int* fill = (int*)calloc(n_var + 1, sizeof(int));
+	for (int e = 0; e < n_edges; e++) {
+		struct edge* edge = &graph->edges[e];
+		p->prev_into[e] = last_into[edge->dst];
+		last_into[edge->dst] = e;
+		queue[queue_start[edge->dst] + fill[edge->dst]++] = e;
+		if (edge->src_is_input || edge->src_version == 0) {
+			p->producer[e] = -1;
+		} else {
+			p->producer[e] = queue[queue_start[edge->src] + edge->src_version - 1];
+		}
+	}
+	free(fill);
+	free(queue);
+	free(queue_start);
+	free(last_into);
+}
+
+/*
+*	Mark the start of a row
+*/
+void profile_row_start(struct profile* p) {
+	p->row.start = profile_now();
+	p->n_unstamped = 0;
+}
+
+/*
+*	Note that an edge was sent. Its time is filled in by profile_stamp_sent when the messages are written.
+*/
+void profile_sent(struct profile* p, int edge) {
+	p->unstamped[p->n_unstamped++] = edge;
+}
+
+/*
+*	Fill in the time the edges noted by profile_sent were sent. It is called just before they are written, so that no
+*	worker can have started on them before that time.
+*/
+void profile_stamp_sent(struct profile* p) {
+	if (p->n_unstamped == 0) {
+		return;
+	}
+	long now = profile_now();
+	for (int i = 0; i < p->n_unstamped; i++) {
+		p->row.sent[p->unstamped[i]] = now;
+	}
+	p->n_unstamped = 0;
+}
+
+/*
+*	Mark the end of a row, and keep its times if it is the slowest row so far
+*/
+void profile_row_end(struct profile* p) {
+	struct row_times* row = &p->row;
+	row->end = profile_now();
+	int n_edges = p->graph->n_edges;
+	for (int e = 0; e < n_edges; e++) {
+		p->total_latency[e] += row->done[e] - row->sent[e];
+		p->total_apply[e] += row->apply_ns[e];
+	}
+	if (p->slowest_row == -1 || row->end - row->start > p->slowest.end - p->slowest.start) {
+		p->slowest_row = p->rows;
+		p->slowest.start = row->start;
+		p->slowest.end = row->end;
+		memcpy(p->slowest.sent, row->sent, sizeof(long) * n_edges);
+		memcpy(p->slowest.applied, row->applied, sizeof(long) * n_edges);
+		memcpy(p->slowest.apply_ns, row->apply_ns, sizeof(int) * n_edges);
+		memcpy(p->slowest.done, row->done, sizeof(long) * n_edges);
+	}
+	p->rows++;
+}
+
+/*
+*	The workers time the edges on their own clock, which is the same clock for workers on this machine but not for
+*	workers on others. A worker has to have started an edge after it was sent and finished it before the result came
+*	back, which bounds how far its clock can be from the coordinator's. It returns the offset to add to the times of
+*	the worker: 0 if that fits in the bounds, and the middle of the bounds if not.
+*/
+static long clock_offset(struct profile* p, int worker) {
+	struct row_times* row = &p->slowest;
+	long low = -(1L << 62);
+	long high = 1L << 62;
+	for (int e = 0; e < p->graph->n_edges; e++) {
+		if (p->graph->edges[e].dst % p->n_workers != worker) {
+			continue;
+		}
+		if (row->sent[e] - row->applied[e] > low) {
+			low = row->sent[e] - row->applied[e];
+		}
+		if (row->done[e] - (row->applied[e] + row->apply_ns[e]) < high) {
+			high = row->done[e] - (row->applied[e] + row->apply_ns[e]);
+		}
+	}
+	if (low <= 0 && 0 <= high) {
+		return 0;
+	}
+	return low / 2 + high / 2;
+}
+
+/*
+*	Write the line of the graph an edge came from, such as "+ a -> p0"
+*/
+static void describe_edge(struct precedence_graph* graph, int e, char* out, size_t size) {
+	const char* ops[] = {"", "+ ", "- ", "* ", "/ "};
+	struct edge* edge = &graph->edges[e];
+	char* src = edge->src_is_input ? graph->input_var[edge->src].name : graph->internal_var[edge->src].name;
+	snprintf(out, size, "%s%s -> %s", ops[edge->op], src, graph->internal_var[edge->dst].name);
+}
+
+/*
+*	Find the critical path of the slowest row and write it to prefix.dot (the graph of the edges, colored by the
+*	time each took on average) and prefix.json (a Chrome trace of the slowest row with one track per worker).
+*	A summary of the critical path is printed to stderr. It returns 0 on success and -1 on failure.
+*/
+int write_profile(struct profile* p, char* prefix) {
+	struct precedence_graph* graph = p->graph;
+	struct row_times* row = &p->slowest;
+	int n_edges = graph->n_edges;
+	if (p->slowest_row == -1 || n_edges == 0) {
+		fprintf(stderr, "nothing was profiled\n");
+		return -1;
+	}
+
+	/*
+	*	Put the times of the workers on the clock of the coordinator
+	*/
+	long* offset = (long*)malloc(sizeof(long) * p->n_workers);
+	for (int w = 0; w < p->n_workers; w++) {
+		offset[w] = clock_offset(p, w);
+	}
+	long* applied = (long*)malloc(sizeof(long) * n_edges);
+	long* finished = (long*)malloc(sizeof(long) * n_edges);
+	for (int e = 0; e < n_edges; e++) {
+		applied[e] = row->applied[e] + offset[graph->edges[e].dst % p->n_workers];
+		finished[e] = applied[e] + row->apply_ns[e];
+	}
+
+	/*
+	*	Walk the critical path back from the last result. ready[e] is when the edge e waited on finished.
+	*/
+	int last = 0;
+	for (int e = 1; e < n_edges; e++) {
+		if (row->done[e] > row->done[last]) {
+			last = e;
+		}
+	}
+	// via[e] is 1 if edge e of the critical path waited on the edge before it into the same variable, and 2 if it
+	// waited on the edge that wrote its value. chain holds the critical path from the last edge back to the first.
+	char* critical = (char*)calloc(n_edges, sizeof(char));
+	char* via = (char*)calloc(n_edges, sizeof(char));
+	long* ready = (long*)malloc(sizeof(long) * n_edges);
+	int* chain = (int*)malloc(sizeof(int) * n_edges);
+	int n_critical = 0;
+	long coordinator_ns = 0;
+	long to_worker_ns = 0;
+	long apply_ns = 0;
+	long back_ns = 0;
+	for (int e = last; e != -1; ) {
+		critical[e] = 1;
+		chain[n_critical++] = e;
+		int before = p->prev_into[e];
+		int writer = p->producer[e];
+		long before_time = before == -1 ? row->start : finished[before];
+		long writer_time = writer == -1 ? row->start : row->done[writer];
+		ready[e] = before_time > writer_time ? before_time : writer_time;
+		if (before == -1 && writer == -1) {
+			e = -1;
+		} else if (writer == -1 || (before != -1 && before_time >= writer_time)) {
+			via[e] = 1;
+			e = before;
+		} else {
+			via[e] = 2;
+			e = writer;
+		}
+	}
+
+	/*
+	*	Split the time of the path into its parts. An edge that waited on the edge before it into the same variable
+	*	is often sent before that edge finished, and then only waits in the worker. The time to get a result back
+	*	only counts for an edge whose result the next edge of the path waited on.
+	*/
+	for (int i = 0; i < n_critical; i++) {
+		int e = chain[i];
+		long sent = row->sent[e] > ready[e] ? row->sent[e] : ready[e];
+		coordinator_ns += sent - ready[e];
+		to_worker_ns += applied[e] - sent;
+		apply_ns += row->apply_ns[e];
+		if (i == 0 || via[chain[i - 1]] == 2) {
+			back_ns += row->done[e] - finished[e];
+		}
+	}
+	long row_ns = row->end - row->start;
+	fprintf(stderr, "critical path of row %ld: %d of %d edges, %.1fus of the row's %.1fus (coordinator %.1fus, to and in the workers %.1fus, applying %.1fus, results back %.1fus, collecting %.1fus)\n",
+		p->slowest_row + 1, n_critical, n_edges, (row->done[last] - row->start) / 1e3, row_ns / 1e3,
+		coordinator_ns / 1e3, to_worker_ns / 1e3, apply_ns / 1e3, back_ns / 1e3, (row->end - row->done[last]) / 1e3);
+
+	char path[strlen(prefix) + 6];
+	char label[64];
+	int status = 0;
+
+	/*
+	*	The DOT graph has a node per edge, colored from blue to red by the average time from sending it to getting
+	*	its result. Solid arrows go from the edge that wrote a value to the edges that read it, dashed arrows from
+	*	one edge into a variable to the next, and the critical path is drawn in bold.
+	*/
+	sprintf(path, "%s.dot", prefix);
+	FILE* dot = fopen(path, "w");
+	if (dot == NULL) {
+		fprintf(stderr, "could not write %s\n", path);
+		status = -1;
+	} else {
+		double hottest = 0;
+		for (int e = 0; e < n_edges; e++) {
+			if (p->total_latency[e] > hottest) {
+				hottest = p->total_latency[e];
+			}
+		}
+		fprintf(dot, "digraph profile {\n\trankdir=LR;\n\tnode [shape=box, style=filled, fontname=\"Helvetica\"];\n");
+		for (int e = 0; e < n_edges; e++) {
+			double heat = hottest > 0 ? p->total_latency[e] / hottest : 0;
+			describe_edge(graph, e, label, sizeof(label));
+			fprintf(dot, "\te%d [label=\"e%d: %s\\nlatency %.1fus\\napply %.2fus\", fillcolor=\"%.3f 0.600 1.000\"%s];\n",
+				e, e, label, p->total_latency[e] / p->rows / 1e3, p->total_apply[e] / p->rows / 1e3, 0.66 * (1 - heat),
+				critical[e] ? ", penwidth=3" : "");
+		}
+		for (int e = 0; e < n_edges; e++) {
+			if (p->producer[e] != -1) {
+				fprintf(dot, "\te%d -> e%d%s;\n", p->producer[e], e, via[e] == 2 ? " [penwidth=3, color=red]" : "");
+			}
+			if (p->prev_into[e] != -1) {
+				fprintf(dot, "\te%d -> e%d [style=dashed%s];\n", p->prev_into[e], e, via[e] == 1 ? ", penwidth=3, color=red" : "");
+			}
+		}
+		fprintf(dot, "}\n");
+		fclose(dot);
+	}
+
+	/*
+	*	The Chrome trace (chrome://tracing or ui.perfetto.dev) has a track per worker with the edges it applied,
+	*	a track for the coordinator with the row, and a track with the edges of the critical path, each from the time
+	*	it could go to the time the next edge of the path could. The times are in microseconds from the start of the row.
+	*/
+	sprintf(path, "%s.json", prefix);
+	FILE* json = fopen(path, "w");
+	if (json == NULL) {
+		fprintf(stderr, "could not write %s\n", path);
+		status = -1;
+	} else {
+		fprintf(json, "{\"traceEvents\":[\n");
+		fprintf(json, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"row %ld\"}},\n", p->slowest_row + 1);
+		fprintf(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"coordinator\"}},\n");
+		for (int w = 0; w < p->n_workers; w++) {
+			fprintf(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"worker %d\"}},\n", w + 1, w);
+		}
+		fprintf(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"critical path\"}},\n", p->n_workers + 1);
+		fprintf(json, "{\"name\":\"row\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":0,\"dur\":%.3f},\n", row_ns / 1e3);
+		fprintf(json, "{\"name\":\"collect\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f},\n",
+			(row->done[last] - row->start) / 1e3, (row->end - row->done[last]) / 1e3);
+		for (int e = 0; e < n_edges; e++) {
+			describe_edge(graph, e, label, sizeof(label));
+			fprintf(json, "{\"name\":\"e%d: %s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+				"\"args\":{\"sent\":%.3f,\"done\":%.3f}},\n",
+				e, label, critical[e] ? "apply,critical" : "apply", graph->edges[e].dst % p->n_workers + 1,
+				(applied[e] - row->start) / 1e3, row->apply_ns[e] / 1e3, (row->sent[e] - row->start) / 1e3, (row->done[e] - row->start) / 1e3);
+		}
+		for (int i = n_critical - 1; i >= 0; i--) {
+			int e = chain[i];
+			long until = i == 0 ? row->done[last] : ready[chain[i - 1]];
+			describe_edge(graph, e, label, sizeof(label));
+			fprintf(json, "{\"name\":\"e%d: %s\",\"cat\":\"critical\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+				e, label, p->n_workers + 1, (ready[e] - row->start) / 1e3, (until - ready[e]) / 1e3, i == 0 ? "" : ",");
+		}
+		fprintf(json, "],\"displayTimeUnit\":\"ns\"}\n");
+		fclose(json);
+	}
+
+	free(offset);
+	free(applied);
+	free(finished);
+	free(critical);
+	free(via);
+	free(ready);
+	free(chain);
+	return status;
+}
+
+/*
+*	Free what the profile allocated
+*/
+void destroy_profile(struct profile* p) {
+	free_row_times(&p->row);
+	free_row_times(&p->slowest);
+	free(p->prev_into);
+	free(p->producer);
+	free(p->total_latency);
+	free(p->total_apply);
+	free(p->unstamped);
+}
@@ -0,0 +1,84 @@
+struct precedence_graph;
+
+/*
+*	The profile of a run. For every edge of the row being evaluated, it keeps when the coordinator sent it, when the
+*	worker started and finished applying it (on the clock of the worker), and when the coordinator got the result.
+*	The times of the slowest row are kept for the export, and the time every edge took is added up over all of the
+*	rows for the heat of the DOT graph.
+*
+*	The times are in nanoseconds of CLOCK_MONOTONIC.
+*/
+struct row_times {
+	long start;
+	long end;
+	long* sent;
+	long* applied;
+	int* apply_ns;
+	long* done;
+};
+
+struct profile {
+	struct precedence_graph* graph;
+	int n_workers;
+
+	// the edge into the same variable before each edge, and the edge that wrote the value each edge reads (or -1)
+	int* prev_into;
+	int* producer;
+
+	struct row_times row;
+	struct row_times slowest;
+	long rows;
+	long slowest_row;
+
+	double* total_latency;
+	double* total_apply;
+
+	// the edges sent since the last time the sent times were filled in
+	int* unstamped;
+	int n_unstamped;
+};
+
+
+
+/*
+*	The time on the clock the profile uses
+*/
+long profile_now();
+
+/*
+*	Get a profile ready for the graph, evaluated by n_workers workers
+*/
+void start_profile(struct profile* p, struct precedence_graph* graph, int n_workers);
+
+/*
+*	Mark the start of a row
+*/
+void profile_row_start(struct profile* p);
+
+/*
+*	Note that an edge was sent. Its time is filled in by profile_stamp_sent when the messages are written.
+*/
+void profile_sent(struct profile* p, int edge);
+
+/*
+*	Fill in the time the edges noted by profile_sent were sent. It is called just before they are written, so that no
+*	worker can have started on them before that time.
+*/
+void profile_stamp_sent(struct profile* p);
+
+/*
+*	Mark the end of a row, and keep its times if it is the slowest row so far
+*/
+void profile_row_end(struct profile* p);
+
+/*
+*	Find the critical path of the slowest row and write it to prefix.dot (the graph of the edges, colored by the
+*	time each took on average) and prefix.json (a Chrome trace of the slowest row with one track per worker).
+*	A summary of the critical path is printed to stderr. It returns 0 on success and -1 on failure.
+*/
+int write_profile(struct profile* p, char* prefix);
+
+/*
+*	Free what the profile allocated
+*/
+void destroy_profile(struct profile* p);
@@ -0,0 +1,236 @@
+/*
+*	Recording and replaying the messages of a run. The trace starts with a header, followed by one fixed-size record
+*	per message: the time since the record before it, the worker, whether it was sent or received, and the message
+*	itself. The records are written through a large stdio buffer, so recording costs one clock read and a copy per batch.
+*/
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+
+#include "values.h"
+#include "coordinator.h"
+#include "trace.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	The header says which version of the messages the trace holds, since a trace of messages of another size
+*	cannot be replayed
+*/
+struct trace_header {
+	char magic[4];
+	int version;
+	int message_size;
+	int n_workers;
+};
+
+struct trace_record {
+	unsigned int delta_ns;
+	unsigned short worker;
+	unsigned short flags;
+	struct message msg;
+};
+
+#define TRACE_VERSION 1
+
+/*
+*	The size of the stdio buffer of the trace file
+*/
+#define TRACE_BUFFER (1 << 20)
+
+static long now_in_ns() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+/*
+*	Start recording a trace of a run with n_workers workers to path. It returns 0 on success and -1 on failure.
+*/
+int open_trace(struct trace_writer* trace, char* path, int n_workers) {
+	trace->file = fopen(path, "wb");
+	if (trace->file == NULL) {
+		fprintf(stderr, "could not open the trace %s: %s\n", path, strerror(errno));
+		return -1;
+	}
+	setvbuf(trace->file, NULL, _IOFBF, TRACE_BUFFER);
+
+	struct trace_header header;
+	memcpy(header.magic, "PGTR", 4);
+	header.version = TRACE_VERSION;
+	header.message_size = sizeof(struct message);
+	header.n_workers = n_workers;
+	fwrite(&header, sizeof(header), 1, trace->file);
+	trace->last_ns = now_in_ns();
+	trace->n_records = 0;
+	return 0;
+}
+
+/*
+*	Record n messages that were sent to (TRACE_SENT) or received from (TRACE_RECEIVED) a worker at the same time.
+*	The messages that were sent together are marked so that a replay sends them in one write as well.
+*/
+void trace_messages(struct trace_writer* trace, int worker, int direction, struct message* msgs, int n) {
+	long now = now_in_ns();
+	long delta = now - trace->last_ns;
+	trace->last_ns = now;
+	for (int i = 0; i < n; i++) {
+		struct trace_record rec;
+		// only the first message of the batch is later than the record before it
+		rec.delta_ns = i > 0 ? 0 : (delta > UINT_MAX ? UINT_MAX : delta);
+		rec.worker = worker;
+		rec.flags = direction;
+		if (direction == TRACE_SENT && i == n - 1) {
+			rec.flags |= TRACE_END_OF_WRITE;
+		}
+		rec.msg = msgs[i];
+		fwrite(&rec, sizeof(rec), 1, trace->file);
+	}
+	trace->n_records += n;
+}
+
+/*
+*	Finish the trace and close its file
+*/
+void close_trace(struct trace_writer* trace) {
+	fclose(trace->file);
+}
+
+/*
+*	Open a trace and check its header. It returns the file, or NULL if it is not a trace this program can replay.
+*/
+static FILE* open_for_replay(char* path, struct trace_header* header) {
+	FILE* file = fopen(path, "rb");
+	if (file == NULL) {
+		fprintf(stderr, "could not open the trace %s: %s\n", path, strerror(errno));
+		return NULL;
+	}
+	if (fread(header, sizeof(*header), 1, file) != 1 || memcmp(header->magic, "PGTR", 4) != 0) {
+		fprintf(stderr, "%s is not a trace\n", path);
+		fclose(file);
+		return NULL;
+	}
+	if (header->version != TRACE_VERSION || header->message_size != sizeof(struct message)) {
+		fprintf(stderr, "%s was recorded by another version of the messages\n", path);
+		fclose(file);
+		return NULL;
+	}
+	return file;
+}
+
+/*
+*	Read the number of workers a trace was recorded with. It returns -1 if the file is not a trace.
+*/
+int trace_workers(char* path) {
+	struct trace_header header;
+	FILE* file = open_for_replay(path, &header);
+	if (file == NULL) {
+		return -1;
+	}
+	fclose(file);
+	return header.n_workers;
+}
+
+/*
+*	The replies of a worker that were read but whose records in the trace have not been reached yet
+*/
+struct pending_replies {
+	struct message msgs[READ_BATCH];
+	int next;
+	int count;
+};
+
+/*
+*	Send the messages of the trace at path to the workers on the channels, in the order they were recorded. A message
+*	is only sent once every reply that came before it in the trace has come back, and every reply is checked against
+*	the recorded one. If timed is set, the messages are also held back until the time they were sent in the recording.
+*
+*	The replies of one worker come back in the order it was sent the messages, so the next reply a worker sends is
+*	always the next recorded reply from that worker, whichever order the workers answer in.
+*/
+int replay_trace(char* path, struct channel* channels, int n_workers, int timed) {
+	struct trace_header header;
+	FILE* file = open_for_replay(path, &header);
+	if (file == NULL) {
+		return -1;
+	}
+	if (header.n_workers != n_workers) {
+		fprintf(stderr, "the trace was recorded with %d workers, not %d\n", header.n_workers, n_workers);
+		fclose(file);
+		return -1;
+	}
+	setvbuf(file, NULL, _IOFBF, TRACE_BUFFER);
+
+	struct pending_replies* pending = (struct pending_replies*)calloc(n_workers, sizeof(struct pending_replies));
+	long sent = 0;
+	long received = 0;
+	long different = 0;
+	long recorded_ns = 0;
+	long start = now_in_ns();
+	int status = 0;
+
+	struct trace_record rec;
+	while (status == 0 && fread(&rec, sizeof(rec), 1, file) == 1) {
+		if (rec.worker >= n_workers) {
+			fprintf(stderr, "the trace names worker %d, which does not exist\n", rec.worker);
+			status = -1;
+			break;
+		}
+		recorded_ns += rec.delta_ns;
+		struct channel* ch = &channels[rec.worker];
+
+		if (!(rec.flags & TRACE_RECEIVED)) {
+			if (timed) {
+				long wait = start + recorded_ns - now_in_ns();
+				if (wait > 0) {
+					struct timespec ts = {wait / 1000000000L, wait % 1000000000L};
+					nanosleep(&ts, NULL);
+				}
+			}
+			status = queue_message(ch, &rec.msg);
+			if (status == 0 && (rec.flags & TRACE_END_OF_WRITE)) {
+				status = flush_channel(ch);
+			}
+			sent++;
+			continue;
+		}
+
+		/*
+		*	A recorded reply, so wait for the next reply of the same worker if it was not read already
+		*/
+		struct pending_replies* p = &pending[rec.worker];
+		while (status == 0 && p->next == p->count) {
+			int n = read_replies(ch, p->msgs);
+			if (n == -1) {
+				fprintf(stderr, "worker %d stopped during the replay\n", rec.worker);
+				status = -1;
+			}
+			p->next = 0;
+			p->count = n > 0 ? n : 0;
+		}
+		if (status == 0) {
+			struct message* got = &p->msgs[p->next++];
+			// the times in a TIMING are different in every run
+			int same_value = got->type == MSG_TIMING || got->value.i == rec.msg.value.i;
+			if (got->type != rec.msg.type || got->edge != rec.msg.edge || got->var != rec.msg.var || !same_value) {
+				different++;
+			}
+			received++;
+		}
+	}
+	for (int w = 0; w < n_workers && status == 0; w++) {
+		status = flush_channel(&channels[w]);
+	}
+	double seconds = (now_in_ns() - start) / 1e9;
+
+	fprintf(stderr, "replayed %ld messages sent and %ld received with %d workers in %.3fs (recorded in %.3fs), %ld replies differed\n",
+		sent, received, n_workers, seconds, recorded_ns / 1e9, different);
+	free(pending);
+	fclose(file);
+	return status == 0 && different == 0 ? 0 : -1;
+}
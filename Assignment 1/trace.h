@@ -0,0 +1,56 @@
+#include <stdio.h>
+
+struct message;
+struct channel;
+
+/*
+*	A trace is a binary log of every message that went between the coordinator and the workers, in the order the
+*	coordinator sent and received them, with the time of each. Since the workers only ever talk to the coordinator,
+*	this order is the whole schedule of a run, and replaying it against another set of workers gives both of them the
+*	same schedule to compare on.
+*/
+#define TRACE_SENT 0
+#define TRACE_RECEIVED 1
+#define TRACE_END_OF_WRITE 2
+
+/*
+*	The writer that records a trace. Every channel that has it set records the messages it sends and receives.
+*/
+struct trace_writer {
+	FILE* file;
+	long last_ns;
+	long n_records;
+};
+
+
+
+/*
+*	Start recording a trace of a run with n_workers workers to path. It returns 0 on success and -1 on failure.
+*/
+int open_trace(struct trace_writer* trace, char* path, int n_workers);
+
+/*
+*	Record n messages that were sent to (TRACE_SENT) or received from (TRACE_RECEIVED) a worker at the same time.
+*	The messages that were sent together are marked so that a replay sends them in one write as well.
+*/
+void trace_messages(struct trace_writer* trace, int worker, int direction, struct message* msgs, int n);
+
+/*
+*	Finish the trace and close its file
+*/
+void close_trace(struct trace_writer* trace);
+
+/*
+*	Read the number of workers a trace was recorded with. It returns -1 if the file is not a trace.
+*/
+int trace_workers(char* path);
+
+/*
+*	Send the messages of the trace at path to the workers on the channels, in the order they were recorded. A message
+*	is only sent once every reply that came before it in the trace has come back, and every reply is checked against
+*	the recorded one. If timed is set, the messages are also held back until the time they were sent in the recording.
+*
+*	The time the replay took is printed to stderr next to the time of the recording. It returns 0 if every reply
+*	matched, and -1 on failure or if a reply was different.
+*/
+int replay_trace(char* path, struct channel* channels, int n_workers, int timed);
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "values.h"
+
+static const char* type_names[] = {"int", "int64", "double", "checked"};
+
+/*
+*	Find the type with the given name ("int", "int64", "double" or "checked"). It returns -1 if there is none.
+*/
+int parse_value_type(char* name) {
+	for (int t = 0; t < 4; t++) {
+		if (strcmp(name, type_names[t]) == 0) {
+			return t;
+		}
+	}
+	return -1;
+}
+
+/*
+*	The name of a type, as parse_value_type reads it
+*/
+const char* value_type_name(int type) {
+	return type >= 0 && type < 4 ? type_names[type] : "unknown";
+}
+
+/*
+*	Read a value of the given type from the text of a number. An int is cut down to 32 bits, the way atoi did.
+*/
+union value parse_value(int type, char* text) {
+	union value value;
+	if (type == VALUE_DOUBLE) {
+		value.f = strtod(text, NULL);
+	} else if (type == VALUE_INT) {
+		value.i = (int)strtoll(text, NULL, 10);
+	} else {
+		value.i = strtoll(text, NULL, 10);
+	}
+	return value;
+}
+
+/*
+*	Print a value of the given type. Doubles are printed with enough digits to be read back exactly, and NaN is
+*	printed without the sign it happens to carry.
+*/
+void print_value(FILE* output, int type, union value value) {
+	if (type == VALUE_DOUBLE && isnan(value.f)) {
+		fprintf(output, "nan");
+	} else if (type == VALUE_DOUBLE) {
+		fprintf(output, "%.17g", value.f);
+	} else {
+		fprintf(output, "%lld", value.i);
+	}
+}
@@ -0,0 +1,47 @@
+#include <stdio.h>
+
+/*
+*	These are the types the values of a graph can have. Every variable of a graph has the same type, which is given by
+*	a "value_type <type>;" line before input_var in the graph file, or by -t.
+*
+*	VALUE_INT is the int of the original program, which wraps around at 32 bits. VALUE_INT64 wraps around at 64 bits,
+*	VALUE_DOUBLE is a double, and VALUE_CHECKED is a 64 bit integer where an operation that would overflow is reported
+*	and leaves the value as it was, the same as a division by zero.
+*/
+enum value_type {
+	VALUE_INT,
+	VALUE_INT64,
+	VALUE_DOUBLE,
+	VALUE_CHECKED
+};
+
+/*
+*	A value of any of the types. The integer types are kept in i (VALUE_INT in the low 32 bits' range), and
+*	VALUE_DOUBLE in f. A value of all zero bits is 0 in every type.
+*/
+union value {
+	long long i;
+	double f;
+};
+
+
+
+/*
+*	Find the type with the given name ("int", "int64", "double" or "checked"). It returns -1 if there is none.
+*/
+int parse_value_type(char* name);
+
+/*
+*	The name of a type, as parse_value_type reads it
+*/
+const char* value_type_name(int type);
+
+/*
+*	Read a value of the given type from the text of a number
+*/
+union value parse_value(int type, char* text);
+
+/*
+*	Print a value of the given type
+*/
+void print_value(FILE* output, int type, union value value);
@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "arena.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+// every piece handed out starts at a multiple of this, so that it can hold any type
+#define ARENA_ALIGNMENT 16
+
+/*
+*	This function allocates a block that holds size bytes, with the memory right after the block itself
+*/
+static struct arena_block* new_block(size_t size) {
+	struct arena_block* block = (struct arena_block*)malloc(sizeof(struct arena_block) + ARENA_ALIGNMENT + size);
+	if (block == NULL) {
+		fprintf(stderr, "could not allocate a block of %zu bytes for the arena\n", size);
+		return NULL;
+	}
+	block->next = NULL;
+	block->size = size;
+	block->used = 0;
+	// the memory starts at the first multiple of ARENA_ALIGNMENT after the block
+	size_t start = (size_t)(block + 1);
+	block->memory = (char*)((start + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT);
+	return block;
+}
+
+/*
+*	This function sets up an arena whose blocks hold block_size bytes. It returns 0 on success and -1 if the memory
+*	could not be allocated.
+*/
+int init_arena(struct arena* arena, size_t block_size) {
+	arena->block_size = block_size;
+	arena->first = new_block(block_size);
+	arena->block = arena->first;
+	return arena->first == NULL ? -1 : 0;
+}
+
+/*
+*	This function hands out size bytes of the arena, or returns NULL if the memory could not be allocated
+*/
+void* arena_alloc(struct arena* arena, size_t size) {
+	size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+	struct arena_block* block = arena->block;
+	while (block->used + size > block->size) {
+		if (block->next == NULL || block->next->size < size) {
+			// put a new block after this one, big enough for the piece
+			struct arena_block* added = new_block(size > arena->block_size ? size : arena->block_size);
+			if (added == NULL) {
+				return NULL;
+			}
+			added->next = block->next;
+			block->next = added;
+		}
+		block = block->next;
+		block->used = 0;
+	}
+	arena->block = block;
+	void* piece = block->memory + block->used;
+	block->used += size;
+	return piece;
+}
+
+/*
+*	This function copies the string into the arena, or returns NULL if the memory could not be allocated
+*/
+char* arena_strdup(struct arena* arena, const char* string) {
+	size_t length = strlen(string);
+	char* copy = (char*)arena_alloc(arena, length + 1);
+	if (copy != NULL) {
+		memcpy(copy, string, length + 1);
+	}
+	return copy;
+}
+
+/*
+*	This function returns how far the arena has handed out memory, for reset_arena
+*/
+struct arena_mark mark_arena(struct arena* arena) {
+	struct arena_mark mark;
+	mark.block = arena->block;
+	mark.used = arena->block->used;
+	return mark;
+}
+
+/*
+*	This function takes back all the memory the arena has handed out since mark
+*/
+void reset_arena(struct arena* arena, struct arena_mark mark) {
+	arena->block = mark.block;
+	arena->block->used = mark.used;
+}
+
+/*
+*	This function frees the blocks of the arena
+*/
+void destroy_arena(struct arena* arena) {
+	struct arena_block* block = arena->first;
+	while (block != NULL) {
+		struct arena_block* next = block->next;
+		free(block);
+		block = next;
+	}
+	arena->first = NULL;
+	arena->block = NULL;
+}
+
+/*
+*	This function sets up an empty string builder with a buffer of capacity bytes in the arena, the terminating zero
+*	included. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_builder(struct string_builder* builder, struct arena* arena, size_t capacity) {
+	builder->buffer = (char*)arena_alloc(arena, capacity);
+	builder->capacity = builder->buffer == NULL ? 0 : capacity;
+	builder->length = 0;
+	builder->truncated = builder->buffer == NULL;
+	if (builder->buffer != NULL) {
+		builder->buffer[0] = '\0';
+	}
+	return builder->buffer == NULL ? -1 : 0;
+}
+
+/*
+*	This function appends the text made from format and the values after it, like printf. If it does not fit, nothing
+*	is appended, truncated is set and it returns -1; otherwise it returns 0.
+*/
+int builder_append(struct string_builder* builder, const char* format, ...) {
+	if (builder->truncated) {
+		return -1;
+	}
+	va_list values;
+	va_start(values, format);
+	size_t room = builder->capacity - builder->length;
+	int written = vsnprintf(builder->buffer + builder->length, room, format, values);
+	va_end(values);
+	if (written < 0 || (size_t)written >= room) {
+		// take back the part that fit
+		builder->buffer[builder->length] = '\0';
+		builder->truncated = TRUE;
+		return -1;
+	}
+	builder->length += written;
+	return 0;
+}
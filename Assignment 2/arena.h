@@ -0,0 +1,88 @@
+/*
+*	An arena hands out memory from big blocks, one piece after the other, so that the master strings and the blocks of
+*	output the engines make for every instruction do not each need a malloc and a free. mark_arena remembers how far the arena has
+*	handed out memory, and reset_arena takes back everything handed out since then at once. The blocks are kept when
+*	the arena is reset and used again, so a loop that resets the arena on every turn stays at the same memory however
+*	long it runs.
+*
+*	block is the block memory is handed out from now. The blocks after it were used before the last reset, and are used
+*	again once it is full.
+*/
+struct arena_block {
+	struct arena_block* next;
+	size_t size;
+	size_t used;
+	char* memory;
+};
+
+struct arena {
+	struct arena_block* first;
+	struct arena_block* block;
+	size_t block_size;
+};
+
+struct arena_mark {
+	struct arena_block* block;
+	size_t used;
+};
+
+/*
+*	A string builder writes a string into a buffer of a fixed capacity, and never past it. truncated is TRUE once
+*	something did not fit.
+*/
+struct string_builder {
+	char* buffer;
+	size_t capacity;
+	size_t length;
+	int truncated;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function sets up an arena whose blocks hold block_size bytes. It returns 0 on success and -1 if the memory
+*	could not be allocated.
+*/
+int init_arena(struct arena* arena, size_t block_size);
+
+/*
+*	This function hands out size bytes of the arena, or returns NULL if the memory could not be allocated
+*/
+void* arena_alloc(struct arena* arena, size_t size);
+
+/*
+*	This function copies the string into the arena, or returns NULL if the memory could not be allocated
+*/
+char* arena_strdup(struct arena* arena, const char* string);
+
+/*
+*	This function returns how far the arena has handed out memory, for reset_arena
+*/
+struct arena_mark mark_arena(struct arena* arena);
+
+/*
+*	This function takes back all the memory the arena has handed out since mark
+*/
+void reset_arena(struct arena* arena, struct arena_mark mark);
+
+/*
+*	This function frees the blocks of the arena
+*/
+void destroy_arena(struct arena* arena);
+
+/*
+*	This function sets up an empty string builder with a buffer of capacity bytes in the arena, the terminating zero
+*	included. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_builder(struct string_builder* builder, struct arena* arena, size_t capacity);
+
+/*
+*	This function appends the text made from format and the values after it, like printf. If it does not fit, nothing
+*	is appended, truncated is set and it returns -1; otherwise it returns 0.
+*/
+int builder_append(struct string_builder* builder, const char* format, ...);
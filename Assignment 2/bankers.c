@@ -0,0 +1,447 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "bankers.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	This function returns TRUE if row[j] <= limit[j] for every one of the m resource types, and FALSE as soon as one
+*	of them does not fit. With AVX2 (compiled with -mavx2 or -march=native) 8 resource types are compared at a time,
+*	with SSE2 4 at a time, and otherwise one at a time.
+*/
+static inline int row_fits(const int* row, const int* limit, int m) {
+	int j = 0;
+#if defined(__AVX2__)
+	for (; j + 8 <= m; j += 8) {
+		__m256i r = _mm256_loadu_si256((const __m256i*)(row + j));
+		__m256i l = _mm256_loadu_si256((const __m256i*)(limit + j));
+		if (_mm256_movemask_epi8(_mm256_cmpgt_epi32(r, l)) != 0) {
+			return FALSE;
+		}
+	}
+#endif
+#if defined(__SSE2__)
+	for (; j + 4 <= m; j += 4) {
+		__m128i r = _mm_loadu_si128((const __m128i*)(row + j));
+		__m128i l = _mm_loadu_si128((const __m128i*)(limit + j));
+		if (_mm_movemask_epi8(_mm_cmpgt_epi32(r, l)) != 0) {
+			return FALSE;
+		}
+	}
+#endif
+	for (; j < m; j++) {
+		if (row[j] > limit[j]) {
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*
+*	Free the memory of the sorted safety algorithm, so that it is allocated again if it is picked
+*/
+static void free_sorted(struct bankers* bankers) {
+	free(bankers->by_need);
+	free(bankers->sort_scratch);
+	free(bankers->next);
+	free(bankers->n_keys);
+	free(bankers->satisfied);
+	free(bankers->ready);
+	bankers->by_need = NULL;
+	bankers->sort_scratch = NULL;
+	bankers->next = NULL;
+	bankers->n_keys = NULL;
+	bankers->satisfied = NULL;
+	bankers->ready = NULL;
+}
+
+/*
+*	Set up the Banker's state for n processes and m resource types in block, which is zeroed
+*/
+static void place_bankers(struct bankers* bankers, int n, int m, int* block, int owns_block) {
+	bankers->n = n;
+	bankers->m = m;
+	bankers->algorithm = SAFETY_PASSES;
+	bankers->by_need = NULL;
+	bankers->sort_scratch = NULL;
+	bankers->next = NULL;
+	bankers->n_keys = NULL;
+	bankers->satisfied = NULL;
+	bankers->ready = NULL;
+	bankers->available = block;
+	bankers->max = bankers->available + m;
+	bankers->allocation = bankers->max + (size_t)n * m;
+	bankers->need = bankers->allocation + (size_t)n * m;
+	bankers->finish = bankers->need + (size_t)n * m;
+	bankers->work = bankers->finish + n;
+	bankers->done = bankers->work + m;
+	bankers->sequence = bankers->done + n;
+	bankers->order = bankers->sequence + n;
+	bankers->n_sequence = 0;
+	bankers->n_order = 0;
+	bankers->warm_hits = 0;
+	bankers->warm_misses = 0;
+	bankers->owns_block = owns_block;
+}
+
+/*
+*	This function returns how many ints the block of the Banker's state holds for n processes and m resource types
+*/
+size_t bankers_block_size(int n, int m) {
+	// available, max, allocation, need, finish, work, done, sequence and order, one after the other
+	return (size_t)m + 3 * (size_t)n * m + n + m + n + n + n;
+}
+
+/*
+*	This function allocates the block for n processes and m resource types. Everything starts at 0, and nothing is
+*	finished. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_bankers(struct bankers* bankers, int n, int m) {
+	int* block = (int*)calloc(bankers_block_size(n, m), sizeof(int));
+	if (block == NULL) {
+		fprintf(stderr, "could not allocate the Banker's state for %d processes and %d resources\n", n, m);
+		return -1;
+	}
+	place_bankers(bankers, n, m, block, TRUE);
+	return 0;
+}
+
+/*
+*	This function picks the safety algorithm safe_state uses: SAFETY_PASSES (the default) goes over the processes
+*	until a pass finishes none, and SAFETY_SORTED sorts the processes by need for every resource type, which is
+*	O(n * m * log n) instead of O(n * n * m) for many processes. It returns 0 on success and -1 if the memory for the
+*	sorted algorithm could not be allocated.
+*/
+int set_safety_algorithm(struct bankers* bankers, int algorithm) {
+	if (algorithm == SAFETY_SORTED && bankers->by_need == NULL) {
+		int n = bankers->n;
+		int m = bankers->m;
+		bankers->by_need = (long long*)malloc(sizeof(long long) * ((size_t)n * m + 1));
+		bankers->sort_scratch = (long long*)malloc(sizeof(long long) * (n + 1));
+		bankers->next = (int*)malloc(sizeof(int) * (m + 1));
+		bankers->n_keys = (int*)malloc(sizeof(int) * (m + 1));
+		bankers->satisfied = (int*)malloc(sizeof(int) * (n + 1));
+		bankers->ready = (int*)malloc(sizeof(int) * (n + 1));
+		if (bankers->by_need == NULL || bankers->sort_scratch == NULL || bankers->next == NULL || bankers->n_keys == NULL
+			|| bankers->satisfied == NULL || bankers->ready == NULL) {
+			fprintf(stderr, "could not allocate the sorted safety algorithm for %d processes and %d resources\n", n, m);
+			free_sorted(bankers);
+			return -1;
+		}
+	}
+	bankers->algorithm = algorithm;
+	return 0;
+}
+
+/*
+*	Give copy, whose block is set up, the safety algorithm and the tables of bankers. If the safety algorithm cannot be
+*	allocated, copy is destroyed and it returns -1.
+*/
+static int copy_tables(struct bankers* copy, struct bankers* bankers) {
+	int n = bankers->n;
+	int m = bankers->m;
+	if (set_safety_algorithm(copy, bankers->algorithm) == -1) {
+		destroy_bankers(copy);
+		return -1;
+	}
+	memcpy(copy->available, bankers->available, sizeof(int) * m);
+	memcpy(copy->max, bankers->max, sizeof(int) * n * m);
+	memcpy(copy->allocation, bankers->allocation, sizeof(int) * n * m);
+	memcpy(copy->need, bankers->need, sizeof(int) * n * m);
+	memcpy(copy->finish, bankers->finish, sizeof(int) * n);
+	return 0;
+}
+
+/*
+*	This function gives copy a Banker's state of its own that is the same as bankers, with the same safety algorithm,
+*	so that a simulation can change it without changing bankers. It returns 0 on success and -1 if the memory could
+*	not be allocated.
+*/
+int copy_bankers(struct bankers* copy, struct bankers* bankers) {
+	if (init_bankers(copy, bankers->n, bankers->m) == -1) {
+		return -1;
+	}
+	return copy_tables(copy, bankers);
+}
+
+/*
+*	This function does what copy_bankers does, but puts the tables of copy in block, bankers_block_size ints of zeroed
+*	memory that the caller owns (like memory shared with other processes), which destroy_bankers leaves alone. It
+*	returns 0 on success and -1 if the memory for the safety algorithm could not be allocated.
+*/
+int copy_bankers_into(struct bankers* copy, struct bankers* bankers, int* block) {
+	place_bankers(copy, bankers->n, bankers->m, block, FALSE);
+	return copy_tables(copy, bankers);
+}
+
+/*
+*	This function sets the need of every process from max, once max has been read
+*/
+void compute_need(struct bankers* bankers) {
+	size_t size = (size_t)bankers->n * bankers->m;
+	for (size_t k = 0; k < size; k++) {
+		bankers->need[k] = bankers->max[k] - bankers->allocation[k];
+	}
+}
+
+/*
+*	This function moves amount instances of resource type j from available to process i. A negative amount moves
+*	them back from process i to available.
+*/
+void allocate(struct bankers* bankers, int i, int j, int amount) {
+	size_t k = (size_t)i * bankers->m + j;
+	bankers->available[j] -= amount;
+	bankers->allocation[k] += amount;
+	bankers->need[k] -= amount;
+}
+
+/*
+*	Sort the keys of one resource type by need. The keys are put in the column in the order of the processes, and
+*	only the need half has to be sorted, so a stable radix sort on the bytes of the need that are used is enough.
+*/
+static void sort_by_need(long long* keys, int n_keys, long long* scratch) {
+	long long largest = 0;
+	for (int k = 0; k < n_keys; k++) {
+		largest |= keys[k];
+	}
+	long long* from = keys;
+	long long* to = scratch;
+	for (int shift = 32; shift < 64 && (largest >> shift) != 0; shift += 8) {
+		int count[257] = {0};
+		for (int k = 0; k < n_keys; k++) {
+			count[((from[k] >> shift) & 0xff) + 1]++;
+		}
+		for (int d = 0; d < 256; d++) {
+			count[d + 1] += count[d];
+		}
+		for (int k = 0; k < n_keys; k++) {
+			to[count[(from[k] >> shift) & 0xff]++] = from[k];
+		}
+		long long* swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != keys) {
+		memcpy(keys, from, sizeof(long long) * n_keys);
+	}
+}
+
+/*
+*	Let process i finish in the safety algorithm: it gives back what it holds to work, and it is the next process of
+*	the order being found
+*/
+static void release_process(struct bankers* bankers, int i) {
+	int m = bankers->m;
+	int* allocation = bankers->allocation + (size_t)i * m;
+	for (int j = 0; j < m; j++) {
+		bankers->work[j] += allocation[j];
+	}
+	bankers->done[i] = TRUE;
+	bankers->order[bankers->n_order++] = i;
+}
+
+/*
+*	Go further down the processes sorted by their need of resource type j, counting resource type j as satisfied
+*	for every process whose need of it now fits in work. A process that becomes satisfied for every resource type is
+*	put on the ready stack.
+*/
+static void satisfy_resource(struct bankers* bankers, int j, int n_sorted, int* n_ready) {
+	long long* column = bankers->by_need + (size_t)j * n_sorted;
+	int k = bankers->next[j];
+	while (k < bankers->n_keys[j] && (column[k] >> 32) <= bankers->work[j]) {
+		int i = (int)(column[k] & 0xffffffff);
+		if (++bankers->satisfied[i] == bankers->m) {
+			bankers->ready[(*n_ready)++] = i;
+		}
+		k++;
+	}
+	bankers->next[j] = k;
+}
+
+/*
+*	The safety algorithm with the processes sorted by need, for the n_left processes that are not done. For every
+*	resource type, they are sorted by their need of it, and a process can finish once work covers its need of every
+*	resource type. Since work only grows, each sorted list is only walked once, so after the sort every process costs
+*	O(m). A need that already fits in work is counted right away instead of being sorted. It returns the number of
+*	processes that are still not done.
+*/
+static int sorted_safe_state(struct bankers* bankers, int n_left) {
+	int n = bankers->n;
+	int m = bankers->m;
+	int* work = bankers->work;
+	int n_sorted = n_left;
+	for (int j = 0; j < m; j++) {
+		bankers->next[j] = 0;
+		bankers->n_keys[j] = 0;
+	}
+	// the need is in the high half of the key and the process in the low half, so the keys sort by need
+	int n_ready = 0;
+	for (int i = 0; i < n; i++) {
+		bankers->satisfied[i] = 0;
+		if (bankers->done[i]) {
+			continue;
+		}
+		int* need = bankers->need + (size_t)i * m;
+		for (int j = 0; j < m; j++) {
+			if (need[j] <= work[j]) {
+				bankers->satisfied[i]++;
+			} else {
+				bankers->by_need[(size_t)j * n_sorted + bankers->n_keys[j]++] = ((long long)need[j] << 32) | i;
+			}
+		}
+		if (bankers->satisfied[i] == m) {
+			bankers->ready[n_ready++] = i;
+		}
+	}
+	for (int j = 0; j < m; j++) {
+		sort_by_need(bankers->by_need + (size_t)j * n_sorted, bankers->n_keys[j], bankers->sort_scratch);
+	}
+
+	while (n_ready > 0) {
+		int i = bankers->ready[--n_ready];
+		release_process(bankers, i);
+		n_left--;
+		int* allocation = bankers->allocation + (size_t)i * m;
+		for (int j = 0; j < m; j++) {
+			if (allocation[j] != 0) {
+				satisfy_resource(bankers, j, n_sorted, &n_ready);
+			}
+		}
+	}
+	return n_left;
+}
+
+/*
+*	The safety algorithm in passes, for the n_left processes that are not done. It goes over the processes again and
+*	again, letting every process whose need fits in work finish and give back what it holds, until a whole pass
+*	finishes no process. It returns the number of processes that are still not done.
+*/
+static int passes_safe_state(struct bankers* bankers, int n_left) {
+	int n = bankers->n;
+	int m = bankers->m;
+	int progress = TRUE;
+	while (n_left > 0 && progress) {
+		progress = FALSE;
+		for (int i = 0; i < n; i++) {
+			if (!bankers->done[i] && row_fits(bankers->need + (size_t)i * m, bankers->work, m)) {
+				release_process(bankers, i);
+				n_left--;
+				progress = TRUE;
+			}
+		}
+	}
+	return n_left;
+}
+
+/*
+*	This function runs the safety algorithm on the current state. It returns TRUE if every process that is not
+*	finished can still finish in some order, and FALSE otherwise.
+*
+*	Most checks come right after a single request or release, so the safe sequence of the last check is tried first,
+*	in one pass. If every process that is not finished can go in that order, the state is safe (a warm start hit).
+*	Otherwise the processes that could go before the order broke stay finished, since giving back resources never
+*	makes a state less safe, and the safety algorithm picked with set_safety_algorithm does the rest (a miss).
+*/
+int safe_state(struct bankers* bankers) {
+	int n = bankers->n;
+	int m = bankers->m;
+	memcpy(bankers->work, bankers->available, sizeof(int) * m);
+	memcpy(bankers->done, bankers->finish, sizeof(int) * n);
+	int n_left = 0;
+	for (int i = 0; i < n; i++) {
+		if (!bankers->done[i]) {
+			n_left++;
+		}
+	}
+
+	bankers->n_order = 0;
+	for (int k = 0; k < bankers->n_sequence && n_left > 0; k++) {
+		int i = bankers->sequence[k];
+		if (bankers->done[i]) {
+			continue;
+		}
+		if (!row_fits(bankers->need + (size_t)i * m, bankers->work, m)) {
+			break;
+		}
+		release_process(bankers, i);
+		n_left--;
+	}
+	if (n_left == 0) {
+		bankers->warm_hits++;
+	} else {
+		bankers->warm_misses++;
+		if (bankers->algorithm == SAFETY_SORTED) {
+			n_left = sorted_safe_state(bankers, n_left);
+		} else {
+			n_left = passes_safe_state(bankers, n_left);
+		}
+	}
+
+	// an unsafe state (usually a request that is turned down) keeps the last safe sequence
+	if (n_left == 0) {
+		int* swap = bankers->sequence;
+		bankers->sequence = bankers->order;
+		bankers->order = swap;
+		bankers->n_sequence = bankers->n_order;
+	}
+	return n_left == 0;
+}
+
+/*
+*	This function checks whether process i can be given request (an array of m amounts) right now: there has to be
+*	enough of every resource type available, and the state has to be safe once it is given. The state is the same
+*	when it returns.
+*/
+int request_is_safe(struct bankers* bankers, int i, int* request) {
+	int m = bankers->m;
+	if (!row_fits(request, bankers->available, m)) {
+		return FALSE;
+	}
+	for (int j = 0; j < m; j++) {
+		allocate(bankers, i, j, request[j]);
+	}
+	int safe = safe_state(bankers);
+	for (int j = 0; j < m; j++) {
+		allocate(bankers, i, j, -request[j]);
+	}
+	return safe;
+}
+
+/*
+*	This function returns the first resource type that request asks for more of than is available, or -1 if there is
+*	enough of every resource type (so a request that is not safe then puts the system into an unsafe state)
+*/
+int request_shortage(struct bankers* bankers, int* request) {
+	for (int j = 0; j < bankers->m; j++) {
+		if (request[j] > bankers->available[j]) {
+			return j;
+		}
+	}
+	return -1;
+}
+
+/*
+*	This function prints how many safety checks there were and how many of them were warm start hits
+*/
+void print_safety_counters(FILE* output, char* name, struct bankers* bankers) {
+	long checks = bankers->warm_hits + bankers->warm_misses;
+	fprintf(output, "%s: %ld safety checks, %ld warm start hits (%.1f%%), %ld misses\n", name, checks, bankers->warm_hits,
+		checks > 0 ? 100.0 * bankers->warm_hits / checks : 0.0, bankers->warm_misses);
+}
+
+/*
+*	This function frees the block
+*/
+void destroy_bankers(struct bankers* bankers) {
+	free_sorted(bankers);
+	if (bankers->owns_block) {
+		free(bankers->available);
+	}
+	bankers->available = NULL;
+}
@@ -0,0 +1,138 @@
+/*
+*	This holds the state of the Banker's algorithm for n processes and m resource types. Every array is a part of one
+*	block of memory, and the matrices are stored row after row, so that the row of process i starts at i * m. The
+*	need matrix is kept up to date with every allocation instead of being computed from max and allocation every time
+*	the safety algorithm runs.
+*
+*	work and done are only used by safe_state. They are allocated with everything else, so that checking for a safe
+*	state never allocates memory. The sorted safety algorithm needs more room than that (see set_safety_algorithm),
+*	which is allocated once when it is picked.
+*
+*	The block can also be memory the caller owns, like the memory the fork engine shares with its children (see
+*	copy_bankers_into).
+*
+*	sequence holds the order in which the processes could finish at the last safe check, which the next check tries
+*	first, and order is where a check puts the order it finds. warm_hits counts the checks that were safe in the order
+*	of sequence, and warm_misses the ones that had to search.
+*/
+enum safety_algorithm {
+	SAFETY_PASSES,
+	SAFETY_SORTED
+};
+
+struct bankers {
+	int n;
+	int m;
+	int algorithm;
+
+	int* available;
+	int* max;
+	int* allocation;
+	int* need;
+	int* finish;
+
+	int* work;
+	int* done;
+	int* sequence;
+	int* order;
+	int n_sequence;
+	int n_order;
+	long warm_hits;
+	long warm_misses;
+	// FALSE if the block belongs to the caller of copy_bankers_into
+	int owns_block;
+
+	// for SAFETY_SORTED: the (need, process) keys of every resource type, sorted by need, how far each resource type
+	// has got through its keys, how many resource types each process has enough of, and the processes that can finish
+	long long* by_need;
+	long long* sort_scratch;
+	int* next;
+	int* n_keys;
+	int* satisfied;
+	int* ready;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function returns how many ints the block of the Banker's state holds for n processes and m resource types
+*/
+size_t bankers_block_size(int n, int m);
+
+/*
+*	This function allocates the block for n processes and m resource types. Everything starts at 0, and nothing is
+*	finished. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_bankers(struct bankers* bankers, int n, int m);
+
+/*
+*	This function picks the safety algorithm safe_state uses: SAFETY_PASSES (the default) goes over the processes
+*	until a pass finishes none, and SAFETY_SORTED sorts the processes by need for every resource type, which is
+*	O(n * m * log n) instead of O(n * n * m) for many processes. It returns 0 on success and -1 if the memory for the
+*	sorted algorithm could not be allocated.
+*/
+int set_safety_algorithm(struct bankers* bankers, int algorithm);
+
+/*
+*	This function gives copy a Banker's state of its own that is the same as bankers, with the same safety algorithm,
+*	so that a simulation can change it without changing bankers. It returns 0 on success and -1 if the memory could
+*	not be allocated.
+*/
+int copy_bankers(struct bankers* copy, struct bankers* bankers);
+
+/*
+*	This function does what copy_bankers does, but puts the tables of copy in block, bankers_block_size ints of zeroed
+*	memory that the caller owns (like memory shared with other processes), which destroy_bankers leaves alone. It
+*	returns 0 on success and -1 if the memory for the safety algorithm could not be allocated.
+*/
+int copy_bankers_into(struct bankers* copy, struct bankers* bankers, int* block);
+
+/*
+*	This function sets the need of every process from max, once max has been read
+*/
+void compute_need(struct bankers* bankers);
+
+/*
+*	This function moves amount instances of resource type j from available to process i. A negative amount moves
+*	them back from process i to available.
+*/
+void allocate(struct bankers* bankers, int i, int j, int amount);
+
+/*
+*	This function runs the safety algorithm on the current state. It returns TRUE if every process that is not
+*	finished can still finish in some order, and FALSE otherwise.
+*
+*	Most checks come right after a single request or release, so the safe sequence of the last check is tried first,
+*	in one pass. If every process that is not finished can go in that order, the state is safe (a warm start hit).
+*	Otherwise the processes that could go before the order broke stay finished, since giving back resources never
+*	makes a state less safe, and the safety algorithm picked with set_safety_algorithm does the rest (a miss).
+*/
+int safe_state(struct bankers* bankers);
+
+/*
+*	This function checks whether process i can be given request (an array of m amounts) right now: there has to be
+*	enough of every resource type available, and the state has to be safe once it is given. The state is the same
+*	when it returns.
+*/
+int request_is_safe(struct bankers* bankers, int i, int* request);
+
+/*
+*	This function returns the first resource type that request asks for more of than is available, or -1 if there is
+*	enough of every resource type (so a request that is not safe then puts the system into an unsafe state)
+*/
+int request_shortage(struct bankers* bankers, int* request);
+
+/*
+*	This function prints how many safety checks there were and how many of them were warm start hits
+*/
+void print_safety_counters(FILE* output, char* name, struct bankers* bankers);
+
+/*
+*	This function frees the block
+*/
+void destroy_bankers(struct bankers* bankers);
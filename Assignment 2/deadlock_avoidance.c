@@ -1,7 +1,7 @@
 /*
 *	This program simulates deadlock avoidance using the Banker's algorithm
 *   combined with Earliest-Deadline-First scheduling (using Longest-Job-First as tie-breaker)
-*   and Least-Laxity-First scheduing (using Shortest-Job-First as tie-breaker). 
+*   and Least-Laxity-First scheduing (using Shortest-Job-First as tie-breaker), or any of the other schedulers in scheduler.h.
 *   
 *   It is an experiment to determine which scheduling works best with the Banker's Algorithm
 */
@@ -9,866 +9,475 @@
 #include <sys/types.h>
 #include <sys/ipc.h>
 #include <sys/sem.h>
+#include <sys/wait.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 
+#include "word_table.h"
+#include "arena.h"
 #include "simple_process.h"
+#include "bankers.h"
+#include "ready_queue.h"
+#include "scheduler.h"
+#include "wait_lists.h"
+#include "event_engine.h"
+#include "shared_state.h"
 
 #define TRUE (1 == 1)
 #define FALSE (1 == 0)
 
 /*
-*	This function reads the instruction strings and returns the type of string it is encoded as an integer
-*	It returns:
-*		- 1 if instruction is calculate
-*		- 2 if instruction is request
-*		- 3 if instruction is use_resource
-*		- 4 if instruction is release
-*		- 5 if instruction is print_resources_used
-*		- 6 if instruction is end.
+*	Leave what the child of process_id did in the shared state for the commanding process: the instruction it stopped
+*	at, the time after it, and the remaining computation time and deadline misses of the process
 */
-int parse_instruction(char* instr_str) {
-	char* temp = strdup(instr_str);
-	char* tok = strtok(temp, "(,);\n");
-	tok = strtok(NULL, "(,);\n");
-	
-	if (strcmp(temp, "calculate") == 0) {
-		return 1;
-	} else if (strcmp(temp, "request") == 0) {
-		return 2;
-	} else if (strcmp(temp, "use_resources") == 0) {
-		return 3;
-	} else if (strcmp(temp, "release") == 0) {
-		return 4;
-	} else if (strcmp(temp, "print_resources_used") == 0) {
-		return 5;
-	} else if (strcmp(temp, "end.") == 0) {
-		return 6;
-	} else {
-		printf("temp (%s)\n", temp);
-		return -1;
-	}
+static void report(struct shared_state* shared, int process_id, int code, int time, struct process* p) {
+	shared->code = code;
+	shared->time = time;
+	shared->remaining[process_id] = p->remaining_computation_time;
+	shared->deadline_misses[process_id] = p->deadline_misses;
 }
 
 /*
-*	Number to string function. Takes in number, returns a string
+*	End the child of process_id: it gives back every resource it holds through the shared state, like a release of
+*	everything, passes the turn back to the commanding process for the last time and exits with status
 */
-char* numb_to_string(int numb) {
-	char dig_buf[5];
-	sprintf(dig_buf, "%d", numb);
-	return strdup(dig_buf);
-}
-
-int safe_state(int n, int m, int* available, int** max, int** allocation, int* true_finish) {
-	// need + allocation = max
-	int* work = (int*)malloc(sizeof(int) * m);
-	int* finish = (int*)malloc(sizeof(int) * n);
+static void end_child(struct shared_state* shared, int sid3, int n, int m, int process_id, int time, struct process* p,
+	int status) {
 	for (int i = 0; i < m; i++) {
-		work[i] = available[i];
-	}
-	// get the state of all the processes so far
-	for (int i = 0; i < n; i++) {
-		finish[i] = true_finish[i];
-	}
-	int flag = FALSE;
-	while (!flag) {
-		int flag3 = FALSE;
-		for (int i = 0; i < n; i++) {
-			if (!finish[i]) {
-				flag3 = TRUE;
-				int flag2 = TRUE;
-				for (int j = 0; j < m; j++) {
-					flag2 = flag2 && (max[i][j] - allocation[i][j]) <= work[j];
-				}
-				if (flag2) {
-					for (int j = 0; j < m; j++) {
-						work[j] = work[j] + allocation[i][j];
-					}
-					finish[i] = TRUE;
-				}
-			}
+		int* ids = shared_ids(shared, i);
+		shared->n_ids[i] = 0;
+		int id = pop_resource(p->arr_allocated_resrcs, i);
+		while (id != -1) {
+			ids[shared->n_ids[i]++] = id;
+			id = pop_resource(p->arr_allocated_resrcs, i);
 		}
-		// if flag3 is not flagged at all, it would remain false and so set flag to true
-		flag = !flag3;
 	}
+	report(shared, process_id, 6, time, p);
 
-	for (int i = 0; i < n; i++) {
-		if (!finish[i]) {
-			return FALSE;
-		}
+	// signal the commanding process to read
+	struct sembuf op;
+	op.sem_num = n;
+	op.sem_op = 1;
+	op.sem_flg = 0;
+	if (semop(sid3, &op, 1) == -1) {
+		fprintf(stderr, "\nsemop error(41) is: %s\n", strerror(errno));
 	}
-	free(finish);
-	free(work);
-	return TRUE;
+
+	exit(status);
 }
 
 /*
-*	Comparator function for qsort in master_string
+*	Print the state of the system for process idx in one write: available, the row of idx in max, allocation and need,
+*	and its deadline misses. The text is made in the arena, which takes it back after. It returns 0 on success and -1
+*	if the memory could not be allocated.
 */
-int alphabetical_order_comp(const void* p1, const void* p2) {
-	return strcmp((char*)p1, (char*)p2);
+static int print_state(struct arena* arena, struct bankers* bankers, int idx, int deadline_misses) {
+	int m = bankers->m;
+	struct arena_mark mark = mark_arena(arena);
+	struct string_builder builder;
+	// every number takes at most 12 characters with its space, and the names of the rows fit in the rest
+	if (init_builder(&builder, arena, (size_t)m * 4 * 12 + 128) == -1) {
+		return -1;
+	}
+	builder_append(&builder, "State of the system:\navailable = ");
+	for (int i = 0; i < m; i++) {
+		builder_append(&builder, "%d ", bankers->available[i]);
+	}
+	builder_append(&builder, "\nmax[%d] = ", idx+1);
+	for (int j = 0; j < m; j++) {
+		builder_append(&builder, "%d ", bankers->max[idx * m + j]);
+	}
+	builder_append(&builder, "\nallocation[%d] = ", idx+1);
+	for (int j = 0; j < m; j++) {
+		builder_append(&builder, "%d ", bankers->allocation[idx * m + j]);
+	}
+	builder_append(&builder, "\nneed[%d] = ", idx+1);
+	for (int j = 0; j < m; j++) {
+		builder_append(&builder, "%d ", bankers->need[idx * m + j]);
+	}
+	builder_append(&builder, "\ndeadline_misses[%d] = %d\n\n", idx+1, deadline_misses);
+	fwrite(builder.buffer, 1, builder.length, stdout);
+	reset_arena(arena, mark);
+	return builder.truncated ? -1 : 0;
 }
 
 /*
-*	This function takes in the string stored in p_process made from "use_resources", and outputs the master string
-*	for this process
+*	Print the master string of process_id in one write, with the line after it. The text is made in the arena, which
+*	takes it back after. It returns 0 on success and -1 if the memory could not be allocated.
 */
-char* print_master_string(struct process* p_process) {
-	//printf("inside print master string\n");
-	// we first get the number of strings outputted
-	int size_str_arr = p_process->n_str_master;
-	//printf("%d\n", size_str_arr);
-	// we allocate an array of strings
-	char** total_str = (char**) malloc(sizeof(char*) * size_str_arr);
-	
-	// next get all of the strings from master_str
-	char* temp = strdup(p_process->master_str);
-	char* tok = strtok(temp, " ");
-	for (int i = 0; i < size_str_arr; i++) {
-		total_str[i] = strdup(tok);
-		tok = strtok(NULL, " ");
-	}
-
-	// next, sort the array alphebetically
-	qsort(total_str, size_str_arr, sizeof(char*), alphabetical_order_comp);
-
-	// finally, output the string
-	char* final_string = strdup(" ");
-	for (int i = 0; i < size_str_arr; i++) {
-		strcat(final_string, total_str[i]);
-		strcat(final_string, strdup(" "));
-		//printf("%s\n", total_str[i]);
+static int print_master(struct arena* arena, struct process* p, struct word_table* words, int process_id) {
+	struct arena_mark mark = mark_arena(arena);
+	char* master = print_master_string(p, words, arena);
+	struct string_builder builder;
+	if (master == NULL || init_builder(&builder, arena, p->master.length + 128) == -1) {
+		reset_arena(arena, mark);
+		return -1;
 	}
-	//printf("exiting print master string\n");
-
-	return strdup(final_string);
+	builder_append(&builder, "\n%d -- Master string: %s\n\n\n------------------------------------------------------\n\n",
+		process_id + 1, master);
+	fwrite(builder.buffer, 1, builder.length, stdout);
+	reset_arena(arena, mark);
+	return builder.truncated ? -1 : 0;
 }
 
 
 /*
-*	This program will simulate how the Banker's algorithm will allocate resources to processes.
-*	The algorithm will use the Earliest-Deadline-First scheduler (with Longest-Job-First as tie breaker) and 
-*	the Least-Laxity-First scheduler (with Shortest-Job-First as tie breaker).
+*	This function runs the simulation with one scheduler (see scheduler.h) the way the program first worked. This process
+*	becomes the commanding process and forks a child for every simulated process. The commanding process picks the process
+*	to run, puts the time and a time limit in the shared state (see shared_state.h) and passes it the turn through its
+*	semaphore in sid3. The child runs its calculate and use_resources instructions one after the other while the time is
+*	before the limit, and once it has run any other instruction or reached the limit, it leaves what it did in the shared
+*	state and passes the turn back through the semaphore of the commanding process. It returns in the commanding process
+*	once every process has ended.
 *
-*	Two different schedulers mean that two different outputs are given.
+*	The resources go through the shared state as the IDs of their names in words, which only the master strings turn back
+*	into names.
 */
-int main(int argc, char** argv) {
-	/*
-	*   There is a single argument provided as input. It has two integers, m and n,
-	*   in the first two lines, signifying the number of resource types and the number
-	*   of processes respectively. While the assignment specifies two different input formats
-	*   developing the program to account for different formats is unnecessarily complicated.
-	*   Thus the next m and n*m lines are integers to be filled into the AVAILABLE array and MAX
-	*   matrix respectively.
-	* 
-	*   Afterwards, the following lines contain instructions to simulate how the processes will use
-	*   the resources.
-	* 
-	*   The output is the execution of the processes with the EDL scheduler and the LLF scheduler.
-	*	Since two different schedulers are used, output should reflect that
-	*/
-	int n, m;
-	FILE* input = fopen(argv[1], "r");
-
-	/*
-	*   If the files are not provided, exit the program
-	*/
-	if (input == NULL) {
-		printf("The file is null\n");
-		exit(EXIT_FAILURE);
-	}
-
-	/*
-	*	The lines will not exceed 1000 characters, so allocate 1000 characters as a buffer.
-	*	Read the first two integers, initialize the AVAILABLE and MAX data structures, as well as
-	*   any other data structures necessary, and then read the next line.
-	*/
-	size_t len = 1000;
-	char line[len];
-	char sec_line[len];
-	fgets(line, len, input);
-	sscanf(line, "%d", &m);
-	fgets(line, len, input);
-	sscanf(line, "%d", &n);
-
-	/*
-	*	MAX and AVAILABLE are not stored within the process/resource data structure for ease of the 
-	*	safety algorithm
-	*
-	*	RESOURCES is an array of stacks not allocated to any process. When a process requests a specific resource,
-	*	it will go to the stack at the specified index and pop the top, pushing it to the RESOURCE stack held by the process.
-	*	It's important for the m to match the number of resources inside the sample_words.txt. Otherwise, there will be errors.
-	*
-	*	FINISH is an array that indicates whether process at an index is finished
-	*/
-	int* available = (int*)malloc(sizeof(int) * m);
-	int** max = (int**)malloc(sizeof(int*) * n);
-	int** allocation = (int**)malloc(sizeof(int*) * n);
-	struct process* processes = (struct process*)malloc(sizeof(struct process) * n);
-	struct resource** resources = (struct resource**)malloc(sizeof(struct resource*) * m);
-
-	int* finish = (int*)malloc(sizeof(int) * n);
-
+static void run_fork_engine(int scheduler, int n, int m, struct bankers* bankers, struct process* processes,
+	struct resource_stack* resources, struct word_table* words, int sid3) {
+	struct sembuf op;
+	int error;
 
-	for (int i = 0; i < n; i++) {
-		max[i] = (int*)malloc(sizeof(int) * m);
-		allocation[i] = (int*)malloc(sizeof(int) * m);
-		finish[i] = FALSE;
-		processes[i].proc_instructions = NULL;
-		processes[i].master_str = strdup("");
-		processes[i].state = CREATED;
-		processes[i].deadline_misses = 0;
+	const char* name = scheduler_name(scheduler);
+	printf("=======================================\nBANKER'S ALGORITHM WITH %s SCHEDULING\n=======================================\n", name);
 
-		processes[i].arr_allocated_resrcs = (struct resource**)malloc(sizeof(struct resource*) * m);
-		processes[i].request_array = (int*)malloc(sizeof(int) * m);
-		for (int j = 0; j < m; j++) {
-			processes[i].arr_allocated_resrcs[j] = (struct resource*) NULL;;
-			processes[i].request_array[j] = 0;
-		}
- 	}
 
+	// map the memory shared with the child processes, before they are forked, and run on its copy of the Banker's state
+	struct shared_state* shared = map_shared_state(n, m, bankers, processes, resources);
+	if (shared == NULL) {
+		exit(EXIT_FAILURE);
+	}
+	bankers = shared->bankers;
+	int* finish = bankers->finish;
 
-	for (int i = 0; i < m; i++) {
-		fscanf(input, "%d", &available[i]);
-		resources[i] = (struct resource*)NULL;
+	// the state of the system and the master strings are made here, in the commanding process and in every child
+	struct arena strings;
+	if (init_arena(&strings, 4096) == -1) {
+		unmap_shared_state(shared);
+		exit(EXIT_FAILURE);
 	}
+
+	// Create n child processes
+	int process_id = n;
+	int tpid = 1;
 	for (int i = 0; i < n; i++) {
-		for (int j = 0; j < m; j++) {
-			fscanf(input, "%d", &max[i][j]);
-			allocation[i][j] = 0;
+		if (tpid) {
+			tpid = fork();
+			if (!tpid) {
+				process_id = i;
+			}
 		}
 	}
 
 	/*
-	*	There should only need to be one instance of struct sembuf since 
-	*	this is a data structure to send information to the OS to change the internal
-	*	state of the semaphore rather than modify the state directly.
+	*	The commanding process (or deadlock process) computes if the system is in a safe state, and if it is, it finds out which process to
+	*	give priority to and sends a signal to the child process (through semaphore operations) to proceed with computation along with information
+	*	in the shared state. The child processes reads the info that the parent process puts there, and proceeds until the end is reached
+	*	or a "request" or "release" function is called. If the child process sends a request but the request puts the system in a safe state, then the parent
+	*	process will not allow for the child process to proceed until it is free.
 	*
-	*	There is m semaphores corresponding to the number of resources, as well as 1 extra
-	*	semaphore so that the LLF scheduler and EDL scheduler do not run concurrently.
-	*/
-	struct sembuf op;
-	key_t key1 = ftok("temp1.txt", 'A');
-	int sid1 = semget(key1, 1, 0666 | IPC_CREAT);
-	
-	// create n + 1 semaphores, one for each child process, and one for deadlock process
-	// parent process has process_id = n, so the semaphore corresponding to it is semaphore @ n
-	key_t key2 = ftok("temp2.txt", 'B');
-	int sid3 = semget(key2, n + 1, 0666 | IPC_CREAT);
-
-	if (sid1 == -1) {
-        fprintf(stderr, "semget failed: %s\n", strerror(errno));
-	}
-	
-
-	/*
-	*	In decrementing a semaphore, the following instructions are used
-	*		op.sem_num = idx;
-	*		op.sem_op = -1;
-	*		op.sem_flg = 0;
-	*		semop(sid, &op, 1);
-	*	In incrementing a semaphore, the following instructions are executed
-	*		op.sem_num = idx;
-	*		op.sem_op = -1;
-	*		op.sem_flg = 0;
-	*		semop(sid, &op, 1);
-	*/
-	/*
-	op.sem_num = 0;
-	op.sem_op = 1;
-	op.sem_flg = 0;
-	int t = semop(sid1, &op, 1);
-	*/
-
-	/*
-	*	The remaining lines in the file are the processes, their deadline and computation time,
-	*	and their instructions. First read the process line; the next two lines indicate deadline,
-	*	and computation time. The following lines are instructions that the process should execute as
-	*	well as an instruction to print the resources used up so far. Finally, the last instruction
+	*	The scheduler needs to know the time, so the commanding process and the children keep it in the shared state.
 	*/
-	int proc_count = 0;
-	while (!feof(input)) {
-		fgets(line, len, input);
-		strncpy(sec_line, line, strlen("process"));
-		if (strcmp("process", sec_line) == 0) {
-			// we have the start to a process
-			// the next two lines give the deadline and computation time
-			processes[proc_count].proc_id = proc_count;
-			fgets(line, len, input);
-			sscanf(line, "%d", &processes[proc_count].deadline);
-			fgets(line, len, input);
-			sscanf(line, "%d", &processes[proc_count].computation_time);
-			processes[proc_count].remaining_computation_time = processes[proc_count].computation_time;
-
-			int terminate = (1 == 0);
-			while (!feof(input) && !terminate) {
-				fgets(line, len, input);
-				strcpy(sec_line, line);
-				if (strcmp("end.\n", sec_line) == 0) {
-					terminate = (1 == 1);
+	// get the values of the semaphore
+	int time;
+	int instr_time;
+	int safe;
+	int context_switches = 0;
+	if (process_id == n) {
+		// loop until all processes have finished
+		// the time is given by the commanding (deadlock) process
+		time = 0;
+		int all_finished = FALSE;
+
+		// the scheduler keeps the processes that can be picked. requested is the process that was just given a request,
+		// which is ready again after the next pick. waits keeps the waiting processes on the list of what they wait for
+		struct scheduling scheduling;
+		struct wait_lists waits;
+		if (init_scheduling(&scheduling, scheduler, n, processes) == -1 || init_wait_lists(&waits, n, m) == -1) {
+			exit(EXIT_FAILURE);
+		}
+		int requested = -1;
+		
+		while (!all_finished) {
+			// first check if any waiting process that was woken can proceed if its request can be satisfied
+			int n_woken = take_woken(&waits);
+			for (int k = 0; k < n_woken; k++) {
+				int i = waits.woken[k];
+				// the request is given for the check and taken back, since the process makes it again once it runs
+				safe = request_is_safe(bankers, i, processes[i].request_array);
+
+				if (safe) {
+					processes[i].state = READY;
+					schedule_arrival(&scheduling, i);
+				} else {
+					wait_on(&waits, i, request_shortage(bankers, processes[i].request_array));
 				}
-				// store the instructions in the vector					
-				enqueue_instruction(&processes[proc_count].proc_instructions, line);				
-				memset(sec_line, 0, sizeof(sec_line));				
 			}
-			proc_count++;
-		}
-		memset(sec_line, 0, sizeof(sec_line));
-	}
-	fclose(input);
 
-	// test if instruction queue works
-	/*
-	printf("INSTRUCTION OUTPUT\n\n");
-	for (int i = 0; i < n; i++) {
-		printf("PROCESS %d\n", i);
-		char* instruction = deque_instruction(&processes[i].proc_instructions);
-		while(instruction != NULL) {
-			printf("%s\t", instruction);
-			instruction = deque_instruction(&processes[i].proc_instructions);
-		}
-	}*/
+			// the check of every process used to end on the last one that is not waiting, which EDF and LLF start from
+			int idx = n - 1;
+			while (idx >= 0 && processes[idx].state == WAITING) {
+				idx--;
+			}
 
-	input = fopen(argv[2], "r");
-	
-	/*
-	*   If the file is not provided, exit the program
-	*/
-	if (input == NULL) {
-		printf("The file is null\n");
-		exit(EXIT_FAILURE);
-	}
+			// then let the scheduler pick the process to run, which is not finished and can be executed without putting the system in an unsafe state.
+			// -1 means that there is no process it can pick
+			int checked = idx;
+			idx = schedule_next(&scheduling, idx, time);
 
-	// read the resource name and type
-	// somwhere in here, max freaks out
-	int ridx = 0;
-	while (!feof(input)) {
-		fgets(line, len, input);
-		char* tok = strtok(line, ": ,");
-		tok = strtok(NULL, ": ,");
-		tok = strtok(NULL, ": ,");
-		while (tok != NULL) {
-			push_resource(resources, tok, ridx);
-			tok = strtok(NULL, ": ,\n");
-		}
-		ridx++;
-	}
-	fclose(input);
-	memset(line, 0, sizeof(line));
 
-	// test if resource stack works
-	/*
-	printf("First array: %s\n", resources[0]->resource_name);
-	printf("second array: %s\n", resources[0]->next_resource->resource_name);
-	for (int i = 0; i < m; i++) {
-		// char* resource = pop_resource(&resources[i]);
-		char* resource = pop_resource(resources, i);
-		while(resource != NULL) {
-			printf("%s\t", resource);
-			// resource = pop_resource(&resources[i]);
-			resource = pop_resource(resources, i);
-			
-		}
-		printf("\n");
-	}*/
-	
-	// test if string can be parsed
-	/*
-	char temp_string_example[] = "request(1,2,3,4);";
-	char* tok = strtok(temp_string_example, "(,);\n");
-	tok = strtok(NULL, "(,);\n");
-	int idx = 0;
-	int t;
-	printf("request: ");
-	while (tok != NULL) {
-		sscanf(tok, "%d", &t);
-		tok = strtok(NULL, "(,);\n");
-		printf("%d\t", t);
-	}
-	printf("\n");
-	*/
+			// next, change the process with a state of REQUESTED to a state of READY
+			if (requested != -1) {
+				processes[requested].state = READY;
+				schedule_arrival(&scheduling, requested);
+				requested = -1;
+			}
 
-	/*
-	*	Split the program into two, so that the program has two copies of processes and instructions.
-	*	One part runs the Banker's algorithm with an EDL scheduler, and the other runs the Banker's algorithm
-	*	with a LLF scheduler.
-	*
-	*	These will not run consecutively, so that the semaphores can work properly.
-	*/
-	int split = fork();
-	int command_id = 0; // the seperate processes will assume the mantle of a commanding process
-	int error;
-	if (split) {
 
-		// execute EDL and LLF seperatly
-		op.sem_num = 0;
-		op.sem_op = -1;
-		op.sem_flg = 0;
-		error = semop(sid1, &op, 1);
-		if (error == -1) {
-			fprintf(stderr, "\nsemop error(1) is: %s\n", strerror(errno));
-		}
-		
-		printf("=======================================\nBANKER'S ALGORITHM WITH EDF SCHEDULING\n=======================================\n");
+			int code = 9;
+			if (idx != -1) {
+				processes[idx].state = RUNNING;
+				schedule_dispatch(&scheduling, idx);
 
+				// give the child the time, and the time until which the scheduler would pick it again
+				shared->time = time;
+				shared->limit = schedule_time_limit(&scheduling, checked, idx);
 
-		// create n + 1 file descriptors, one for each child process, and one for deadlock process
-		int** fd = (int**)malloc(sizeof(int) * (n + 1));
-		for (int i = 0; i <= n; i++) {
-			fd[i] = (int*)malloc(sizeof(int) * 2);
-			pipe(fd[i]);
-		}
+				// signal chosen semaphore operation to execute code
+				op.sem_num = idx;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(21) is: %s\n", strerror(errno));
+				}
 
-		// Create n child processes
-		int process_id = n;
-		int tpid = 1;
-		for (int i = 0; i < n; i++) {
-			if (tpid) {
-				tpid = fork();
-				if (!tpid) {
-					process_id = i;
+				// child process will execute an instruction, so wait for it to signal
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(22) is: %s\n", strerror(errno));
 				}
+
+				// the child has left the instruction it stopped at (a calculate or use_resources at the time limit, a
+				// request, a release, a print or an end), the time and its remaining computation time in the shared state
+				code = shared->code;
+				time = shared->time;
+				processes[idx].remaining_computation_time = shared->remaining[idx];
 			}
-		}
+			// if no process was picked, the code stays 9
 
-		/*
-		*	The commanding process (or deadlock process) computes if the system is in a safe state, and if it is, it finds out which process to
-		*	give priority to and sends a signal to the child process (through semaphore operations) to proceed with computation along with information
-		*	contained in a pipe. The child processes reads the info that the parent process sends through the pipe, and proceeds until the end is reached
-		*	or a "request" or "release" function is called. If the child process sends a request but the request puts the system in a safe state, then the parent
-		*	process will not allow for the child process to proceed until it is free.
-		*
-		*	Since this fork uses the EDF scheduler with LJF as tie-breaker, the commanding process needs to send info about the time when it pipes information.
-		*/
-		// get the values of the semaphore
-		int time;
-		int instr_time;
-		int safe;
-		if (process_id == n) {
-			// loop until all processes have finished
-			// the time is given by the commanding (deadlock) process
-			time = 0;
-			int all_finished = FALSE;
-			
-			while (!all_finished) {
-				// first check if there is any waiting state that can proceed if request can be satisfied
-				int idx = -1;
-				for (int i = 0; i < n; i++) {
-					if (processes[i].state == WAITING) {
-						safe = TRUE;
-						for (int j = 0; j < m; j++) {
-							if (available[j] < processes[i].request_array[j]) {
-								safe = FALSE;
-							}
-							available[i] = available[i] - processes[i].request_array[j];
-						}
-						safe = safe && safe_state(n, m, available, max, allocation, finish);
 
-						if (safe) {
-							processes[i].state = READY;
-							idx = i;
-						}
-						for (int j = 0; j < m; j++) {
-							available[i] = available[i] + processes[i].request_array[j];
-						}
-					} else {
-						idx = i;
-					}
+			// after getting the code, we can determine the instruction the child ran
+			if (code == 1) {
+				// code returned is 1
+				// the instruction executed is calculate
+			} else if (code == 2) {
+				// the child process is requesting resources, which it put in amounts
+				for (int i = 0; i < m; i++) {
+					processes[idx].request_array[i] = shared->amounts[i];
 				}
 
-				// then find the process with the earliest deadline that is not finished and can be executed without putting the system in an unsafe state
-				// set all_finished to be true; if there is a process that has not finished execution, set it to false
-				all_finished = TRUE;
-				for (int i = 0; i < n; i++) {
-					if (!finish[i]) {
-						if (idx == -1) {
-							idx = i;
-						}
-						//printf("process %d state is [%d] and lax is [%d - %d - %d = %d]\n", i, processes[i].state, processes[i].deadline, time, processes[i].remaining_computation_time, curr_lax);
 
-						if (processes[i].state != WAITING && processes[i].state != REQUESTED) {
-							if (processes[i].deadline < processes[idx].deadline) {
-								idx = i;
-							} else if ((processes[i].deadline == processes[idx].deadline) &&  (processes[i].computation_time > processes[idx].computation_time)) {
-								idx = i;
-							}
-						}
-						all_finished = FALSE;
+				// if there is not enough available or the request puts the system into an unsafe state,
+				// then wait for the resources to become available
+				if (!request_is_safe(bankers, idx, processes[idx].request_array)) {
+					processes[idx].state = WAITING;
+					schedule_block(&scheduling, idx);
+					wait_on(&waits, idx, request_shortage(bankers, processes[idx].request_array));
+
+					// this status code tells the child process that the process will need to wait
+					// and make the request again at a later time
+					shared->status_code = 1;
+				} else {
+					// subtract the request from available and add to allocation
+					for (int i = 0; i < m; i++) {
+						allocate(bankers, idx, i, processes[idx].request_array[i]);
 					}
-				}
 
+					// once the request is satisfied, the process must wait (as per assignment specifications) until
+					// another process makes a request or finishes running. if no other processes makes a request, then continue
+					processes[idx].state = REQUESTED;
+					schedule_block(&scheduling, idx);
+					requested = idx;
 
-				// next, change all processes with a state of REQUESTED to a state of READY
-				// if all_finished is TRUE, then rereun the banker's algorithm so that
-				// REQUESTED isn't missed
-				for (int i = 0; i < n; i++) {
-					if (!finish[i]) {
-						if (processes[i].state == REQUESTED) {
-							processes[i].state = READY;
-							if (all_finished) {
-								if (idx == -1) {
-									idx = i;
-								}
-								if (processes[i].deadline < processes[idx].deadline) {
-									idx = i;
-								} else if ((processes[i].deadline < processes[idx].deadline) &&  (processes[i].computation_time > processes[idx].computation_time)) {
-									idx = i;
-								}
+					// this status code tells the child process to take the IDs of the resources it wants from the shared state
+					shared->status_code = 0;
+					for (int i = 0; i < m; i++) {
+						int* ids = shared_ids(shared, i);
+						shared->n_ids[i] = 0;
+						for (int j = 0; j < processes[idx].request_array[i]; j++) {
+							int id = pop_resource(resources, i);
+							if (id != -1) {
+								ids[shared->n_ids[i]++] = id;
 							}
 						}
 					}
 				}
 
+				// print state of system
+				if (print_state(&strings, bankers, idx, shared->deadline_misses[idx]) == -1) {
+					fprintf(stderr, "could not print the state of process %d\n", idx + 1);
+				}
+
 
-				if (!all_finished) {
-					// clear out everything in line
-					memset(line, 0, len);
+				// signal the requesting process semaphore operation to execute code
+				op.sem_num = idx;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(23) is: %s\n", strerror(errno));
+				}
 
+				// wait for the requesting process to take the answer
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(24) is: %s\n", strerror(errno));
+				}
 
-					// write the time to the code
-					write((fd[idx])[1], numb_to_string(time), strlen(numb_to_string(time)));
-					write((fd[idx])[1], "  ", strlen("  "));
-					processes[idx].state = RUNNING;
+			} else if (code == 3) {
+				// code returned is 3
+				// the instruction executed is use_resources
+			} else if (code == 4) {
+				// if code is 4, the code is releasing resources
 
-					// signal chosen semaphore operation to execute code
-					op.sem_num = idx;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(21) is: %s\n", strerror(errno));
+				// the child process put the amount of every resource type it released in amounts, and the IDs of the
+				// resources it has "popped" in the shared state
+				for (int i = 0; i < m; i++) {
+					allocate(bankers, idx, i, -shared->amounts[i]);
+					if (shared->amounts[i] > 0) {
+						wake_resource(&waits, i);
 					}
 
-					// child process will execute an instruction, so wait for it to signal
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(22) is: %s\n", strerror(errno));
+					// push the IDs of all the resources back onto the stack
+					int* ids = shared_ids(shared, i);
+					for (int j = 0; j < shared->n_ids[i]; j++) {
+						push_resource(resources, ids[j], i);
 					}
-				} else {
-					// if the code is finished, write code 9 so that program doesn't hang on read
-					write((fd[n])[1], "9 ", strlen("9 "));
 				}
 
-				// once the child process has finished executing an instruction
-				// it will send a message along the pipe
+				// there is no need to signal the code since the released resources might allow for previously waiting
+				// processes to continue
 
-				// the child process will send back a request, a release, or an end
-				// read from the pipe dedicated for command process
-				error = read((fd[process_id])[0], line, len);
-				if (error == -1) {
-					fprintf(stderr, "\nread error is: %s\n", strerror(errno));
+			} else if (code == 5) {
+				// if code is 5, print the resources used so far
+				
+				// print state of system
+				if (print_state(&strings, bankers, idx, shared->deadline_misses[idx]) == -1) {
+					fprintf(stderr, "could not print the state of process %d\n", idx + 1);
 				}
-
-
-				// the first integer in the line gives the code
-				int code;
-				char* tok = strtok(strdup(line), " \n");
-				sscanf(tok, "%d", &code);
 				
+				// get deadline misses
+				processes[idx].deadline_misses = shared->deadline_misses[idx];
+				
+				printf("deadline misses = %d\n", processes[idx].deadline_misses);
 
-				// after getting the code of the message, we can determine the instruction the code ran
-				if (code == 1) {
-					// code returned is 1
-					// the instruction executed is calculate
-					// the format of the string is: code time remaining_comp_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-				} else if (code == 2) {
-					// the child process is requesting resources
-					// the format of the string is: code resrc_#1 resrc_#2 ... resrc_#m time remaining_comp_time
-
-					// make sure that the process isn't requesting more resources than available
-					int negative_resrcs = FALSE;
-					for (int i = 0; i < m; i++) {
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &processes[idx].request_array[i]);
-
-						// subtract the request from available and add to allocation
-						available[i] = available[i] - processes[idx].request_array[i];
-						if (available[i] < 0)
-							negative_resrcs = TRUE;
-						(allocation[idx])[i] = (allocation[idx])[i] + processes[idx].request_array[i];
-					}
 
-					// read the time and the remaining computation time of the process
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-					
-
-					// if this puts the system into an unsafe state, then revert the changes
-					// and wait for the resources to become available
-					int status_code;
-					char* str_to_send = strdup("");
-					if (negative_resrcs || !safe_state(n, m, available, max, allocation, finish)) {
-						for (int i = 0; i < m; i++) {
-							available[i] = available[i] + processes[idx].request_array[i];
-							(allocation[idx])[i] = (allocation[idx])[i] - processes[idx].request_array[i];
-						}
+				// signal to child process that deadlock process has recieved print instructions
+				op.sem_num = idx;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(25) is: %s\n", strerror(errno));
+				}
 
-						processes[idx].state = WAITING;
-
-						// sent this status code to the child process to indicate that the process will need to wait
-						// and resubmit the string again at a later time
-						status_code = 1;
-						strcat(str_to_send, strdup("1 "));
-					} else {
-						// once the request is satisfied, the process must wait (as per assignment specifications) until
-						// another process makes a request or finishes running. if no other processes makes a request, then continue
-						processes[idx].state = REQUESTED;
-
-						// send this status code to the child process to tell that it to read the pipe to get the resources it wants
-						status_code = 0;
-						strcat(str_to_send, strdup("0 "));
-
-						// then send the request names in the format: status_code resrc_idx1 #_req_resrc_1 resrc_1_name_1 ... #_req_resrc_2 resrc_2_name_1 ... ... #_req_resrc_m resrc_m_name_1 ... 
-						for (int i = 0; i < m; i++) {
-							strcat(str_to_send, numb_to_string(i));
-							strcat(str_to_send, strdup(" "));
-							strcat(str_to_send, numb_to_string(processes[idx].request_array[i]));
-							strcat(str_to_send, strdup(" "));
-							
-							for (int j = 0; j < processes[idx].request_array[i]; j++) {
-								strcat(str_to_send, pop_resource(resources, i));
-								strcat(str_to_send, strdup(" "));
-							}
-						}
-						//printf("string: %s\n", str_to_send);
-						//printf("request value: ");
-					}
+				// wait for child process to print master string
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(26) is: %s\n", strerror(errno));
+				}
+			} else if (code == 6) {
+				// if code is 6, then the process has finished execution
+				// it functions like a release
 
-					printf("State of the system:\n");
-					// print state of system
-					printf("available = ");
-					for (int i = 0; i < m; i++) {
-						printf("%d ", available[i]);
+				// the child process put the IDs of all the resources it has "popped" in the shared state, so push them
+				// back onto the stack
+				for (int i = 0; i < m; i++) {
+					int* ids = shared_ids(shared, i);
+					for (int j = 0; j < shared->n_ids[i]; j++) {
+						push_resource(resources, ids[j], i);
 					}
-					printf("\n");
-					printf("max[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j]);
-					}
-					printf("\n");
-					printf("allocation[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("need[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j] - (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("deadline_misses[%d] = %d\n\n", idx+1, processes[process_id].deadline_misses);
+				}
 
+				finish[idx] = TRUE;
+				schedule_complete(&scheduling, idx);
+				wake_unsafe(&waits);
+				
+			} else if (code == 9) {
+				// this code is used if all processes have finished
+			}
+			else {
+				fprintf(stderr, "how did we get here?\nThe code in the shared state: %d\n", code);
+			}
 
-					// write response to child process
-					write((fd[idx])[1], str_to_send, strlen(str_to_send));
-
-					// signal the requesting process semaphore operation to execute code
-					op.sem_num = idx;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(23) is: %s\n", strerror(errno));
-					}
-
-					// wait for the requesting process to interpret the message sent
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(24) is: %s\n", strerror(errno));
-					}
-
-				} else if (code == 3) {
-					// code returned is 3
-					// the instruction executed is use_resources
-					// the format of the string is: code time remaining_comp_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-				} else if (code == 4) {
-					// if code is 4, the code is releasing resources
-
-					// the child process returns a string of all the resources it has "popped"
-					// the format of the string is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-					for (int i = 0; i < m; i++) {
-						// read the resource index and number of resources released
-						int resrc_idx, n_of_resrc;
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &resrc_idx);
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &n_of_resrc);
-						available[i] = available[i] + n_of_resrc;
-						(allocation[idx])[i] = (allocation[idx])[i] - n_of_resrc;
-
-						// get the names of all the resources and push them back onto the stack
-						for (int j = 0; j < n_of_resrc; j++) {
-							tok = strtok(NULL, " ");
-							push_resource(resources, tok, resrc_idx);
-						}
-					}
-
-					// get the time and remaining_computation_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-
-					// there is no need to signal the code since the released resources might allow for previously waiting
-					// processes to continue
-
-				} else if (code == 5) {
-					// if code is 5, print the resources used so far
-					// the format of the string is: code deadline_misses time remaining_comp_time
-					
-					printf("State of the system:\n");
-					// print state of system
-					printf("available = ");
-					for (int i = 0; i < m; i++) {
-						printf("%d ", available[i]);
-					}
-					printf("\n");
-					printf("max[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j]);
-					}
-					printf("\n");
-					printf("allocation[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("need[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j] - (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("deadline_misses[%d] = %d\n\n", idx+1, processes[process_id].deadline_misses);
-					
-					// get deadline misses, time, and remaining computation time
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &processes[idx].deadline_misses);
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-					
-					printf("deadline misses = %d\n", processes[idx].deadline_misses);
-
-
-					// signal to child process that deadlock process has recieved print instructions
-					op.sem_num = idx;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(25) is: %s\n", strerror(errno));
-					}
-
-					// wait for child process to print master string
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(26) is: %s\n", strerror(errno));
-					}
-				} else if (code == 6) {
-					// if code is 6, then the process has finished execution
-					// it functions like a release
-
-					// the child process returns a string of all the resources it has "popped"
-					// the format of the string is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-					for (int i = 0; i < m; i++) {
-						// read the resource index and number of resources released
-						int resrc_idx, n_of_resrc;
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &resrc_idx);
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &n_of_resrc);
-
-						// get the names of all the resources and push them back onto the stack
-						for (int j = 0; j < n_of_resrc; j++) {
-							tok = strtok(NULL, " ");
-							push_resource(resources, tok, resrc_idx);
-						}
-					}
+			// the process that ran may have a new place in the ready queue
+			if (idx != -1) {
+				schedule_tick(&scheduling, idx, time);
+			}
 
-					// get the time and remaining_computation_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
+			// check if all is finished
+			all_finished = scheduling.n_left == 0;
+		}
+		context_switches = scheduling.context_switches;
+		destroy_scheduling(&scheduling);
+		destroy_wait_lists(&waits);
+	} else {
+		// in child process, wait until deadlock process allows to proceed
+		op.sem_num = process_id;
+		op.sem_op = -1;
+		op.sem_flg = 0;
+		error = semop(sid3, &op, 1);
+		if (error == -1) {
+			fprintf(stderr, "\nsemop error(27) is: %s\n", strerror(errno));
+		}
 
-					finish[idx] = TRUE;
-					
-				} else if (code == 9) {
-					// this code is sent if all processes have finished
-				}
-				else {
-					fprintf(stderr, "how did we get here?\nThe string in the pipe: %s\n", line);
-				}
-			}
-		} else {
-			// in child process, wait until deadlock process allows to proceed
-			op.sem_num = process_id;
-			op.sem_op = -1;
-			op.sem_flg = 0;
-			error = semop(sid3, &op, 1);
-			if (error == -1) {
-				fprintf(stderr, "\nsemop error(27) is: %s\n", strerror(errno));
+		// the child goes on without a turn of its own after calculate and use_resources, while the time is before limit
+		int limit = 0;
+		int go_on = FALSE;
+		struct instruction_list* instructions = &processes[process_id].proc_instructions;
+		struct instruction* instr = next_instruction(instructions);
+		while (instr != NULL) {
+
+			// read the current time and the limit from the shared state, unless the child still has its last turn
+			if (!go_on) {
+				time = shared->time;
+				limit = shared->limit;
 			}
+			go_on = FALSE;
 
-			char* string = deque_instruction(&processes[process_id].proc_instructions);
-			while (string != NULL) {
-
-				// read the current time from the pipe
-				read((fd[process_id])[0], line, len);
-				sscanf(line, "%d", &time);
 
+			int icode = instr->code;
+			int* args = instruction_args(instructions, instr);
+			int advance = TRUE;
 
-				int icode = parse_instruction(string);
+			// check if any deadline misses occurred
+			if (time > processes[process_id].deadline) {
+				processes[process_id].deadline_misses++;
+			}
 
-				// check if any deadline misses occurred
-				if (time > processes[process_id].deadline) {
-					processes[process_id].deadline_misses++;
-				}
+			if (icode == 1) {
+				// 1 is calculate
+				instr_time = instr->n_args > 0 ? args[0] : 0;
+				time += instr_time;
+				processes[process_id].remaining_computation_time -= instr_time;
 
-				// storing all previous declarations so that the gcc doesn't throw a fit
-				int n_of_names_resrc = -1;
-				char* tok;
-				char* str_to_send;
-				int idx;
-				int status_code;
-
-				if (icode == 1) {
-					// 1 is calculate
-					sscanf(string, "calculate(%d)", &instr_time);
-					time += instr_time;
-					processes[process_id].remaining_computation_time -= instr_time;
-
-					// the format of the string is: code time remaining_comp_time
-					str_to_send = strdup("1 ");
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-					// send the message to deadlock process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
-					
+				go_on = time < limit;
+				if (!go_on) {
+					// tell the deadlock process what the child did
+					report(shared, process_id, 1, time, &processes[process_id]);
+				
 					// signal the commanding process to read
 					op.sem_num = n;
 					op.sem_op = 1;
@@ -886,153 +495,106 @@ int main(int argc, char** argv) {
 					if (error == -1) {
 						fprintf(stderr, "\nsemop error(30) is: %s\n", strerror(errno));
 					}
+				}
 
-				} else if (icode == 2) {
-					// 2 is request
-					// the assignment demands that after each request, print the state of the process
-					
-					// the request instruction takes 1 computation time
-					time += 1;
-					processes[process_id].remaining_computation_time -= 1;
-
-					// the format of the string is: code resrc_#1 resrc_#2 ... resrc_#m time remaining_comp_time
-					str_to_send = strdup("2 ");
-
-					// load the request array into the string
-					tok = strtok(strdup(string), "(,);\n");
-					tok = strtok(NULL, "(,);\n");
-					idx = 0;
-					while (tok != NULL) {
-						sscanf(tok, "%d", &processes[process_id].request_array[idx]);
-						tok = strtok(NULL, "(,);\n");
-						strcat(str_to_send, numb_to_string(processes[process_id].request_array[idx++]));
-					}
-					// append time and remaining_comp_time to the end of the string
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-					// send the string to the commanding process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(29) is: %s\n", strerror(errno));
-					}
-					
-					// wait for commanding process to send the status code
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(30) is: %s\n", strerror(errno));
-					}
-
-					// once the commanding process has allowed for the process to proceed
-					// read what the commanding process has sent through the pipe
-					read((fd[process_id])[0], line, len);
-
-
-					// get the status code
-					tok = strtok(line, " (,);\n");
-					sscanf(tok, "%d", &status_code);
-
-					
-					if (status_code == 0) {
-						// the string format is: resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... 
-						int resrc_idx, n_of_names_resrc;
-
-						char req_word[20];
-						for (int i = 0; i < m; i++) {
-							tok = strtok(NULL, " (,);\n");
-							sscanf(tok, "%d", &resrc_idx);
+			} else if (icode == 2) {
+				// 2 is request
+				// the assignment demands that after each request, print the state of the process
+				
+				// the request instruction takes 1 computation time
+				time += 1;
+				processes[process_id].remaining_computation_time -= 1;
+
+				// load the request array into the shared state
+				for (int i = 0; i < m; i++) {
+					processes[process_id].request_array[i] = i < instr->n_args ? args[i] : 0;
+					shared->amounts[i] = processes[process_id].request_array[i];
+				}
+				report(shared, process_id, 2, time, &processes[process_id]);
 
-							tok = strtok(NULL, " (,);\n");
-							sscanf(tok, "%d", &n_of_names_resrc);
+				// signal the commanding process to read
+				op.sem_num = n;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(29) is: %s\n", strerror(errno));
+				}
+				
+				// wait for commanding process to send the status code
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(30) is: %s\n", strerror(errno));
+				}
 
-							for (int j = 0; j < n_of_names_resrc; j++) {
-								tok = strtok(NULL, " (,);\n");
-								sscanf(tok, "%s", req_word);
-								push_resource(processes[process_id].arr_allocated_resrcs, req_word, resrc_idx);
-							}
+				
+				// once the commanding process has allowed for the process to proceed, get the status code
+				int status_code = shared->status_code;
+				if (status_code == 0) {
+					// the IDs of the resources given are in the shared state
+					for (int i = 0; i < m; i++) {
+						int* ids = shared_ids(shared, i);
+						for (int j = 0; j < shared->n_ids[i]; j++) {
+							push_resource(processes[process_id].arr_allocated_resrcs, ids[j], i);
 						}
-
-					} else if (status_code == 1) {
-						// store the previous string instruction
-						struct instruction* temp = processes[process_id].proc_instructions;
-						struct instruction* new_head = (struct instruction*)malloc(sizeof(struct instruction));
-						new_head->instruction = strdup(string);
-						new_head->next_instruction = temp;
-						processes[process_id].proc_instructions = new_head;
-
-						// increment the computation time
-						processes[process_id].remaining_computation_time++; 
-					} else {
-						printf("WHAT HAS HAPPENED HERE\n");
 					}
-					
-					printf("\n%d -- Master string: %s\n\n\n", process_id + 1, print_master_string(&processes[process_id]));
-					printf("------------------------------------------------------\n\n");
 
-					// send message to process to continue execution
-					// write((fd[n])[1], "9 ", strlen("9 "));
+				} else if (status_code == 1) {
+					// stay on the request, so that it runs again once the process is picked again
+					advance = FALSE;
 
-					// signal to deadlock process that child has read response
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(31) is: %s\n", strerror(errno));
-					}
+					// increment the computation time
+					processes[process_id].remaining_computation_time++; 
+				} else {
+					printf("WHAT HAS HAPPENED HERE\n");
+				}
+				
+				if (print_master(&strings, &processes[process_id], words, process_id) == -1) {
+					end_child(shared, sid3, n, m, process_id, time, &processes[process_id], EXIT_FAILURE);
+				}
 
-					// finally, wait for the deadlock process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(32) is: %s\n", strerror(errno));
-					}
+				// signal to deadlock process that child has read response
+				op.sem_num = n;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(31) is: %s\n", strerror(errno));
+				}
 
-				} else if (icode == 3) {
-					// 3 is use_resource
-					int y;
-					sscanf(string, "use_resources(%d,%d)", &instr_time, &y);
-					struct resources* temp = NULL;
-					char* t_str;
-					for (int i = 0; i < m; i++) {
-						struct resource* temp = (processes[process_id].arr_allocated_resrcs[i]);
-						for (int j = 0; j < y && temp != NULL; j++) {
-							t_str = temp->resource_name;
-							strcat(processes[process_id].master_str, strdup(" "));
-							strcat(processes[process_id].master_str, strdup(t_str));	//append to master string
-							temp = temp->next_resource;
-							processes[process_id].n_str_master++;
+				// finally, wait for the deadlock process to signal to proceed
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(32) is: %s\n", strerror(errno));
+				}
+
+			} else if (icode == 3) {
+				// 3 is use_resource
+				instr_time = instr->n_args > 0 ? args[0] : 0;
+				int y = instr->n_args > 1 ? args[1] : 0;
+				for (int i = 0; i < m; i++) {
+					// the top of the stack is at the end of its array
+					struct resource_stack* held = &processes[process_id].arr_allocated_resrcs[i];
+					for (int j = 0; j < y && j < held->size; j++) {
+						if (append_master_string(&processes[process_id], words, held->ids[held->size - 1 - j]) == -1) {
+							end_child(shared, sid3, n, m, process_id, time, &processes[process_id], EXIT_FAILURE);
 						}
 					}
-					time += instr_time;
-					processes[process_id].remaining_computation_time -= instr_time;
-
-					// the format of the string is: code time remaining_comp_time
-					str_to_send = strdup("3 ");
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
+				}
+				time += instr_time;
+				processes[process_id].remaining_computation_time -= instr_time;
 
-					// send the string to the commanding process
-					error = write((fd[n])[1], str_to_send, strlen(str_to_send));
-					if (error == -1) {
-						fprintf(stderr, "\nwrite(1) is: %s\n", strerror(errno));
-					}
-					
+				go_on = time < limit;
+				if (!go_on) {
+					// tell the deadlock process what the child did
+					report(shared, process_id, 3, time, &processes[process_id]);
+				
 					// signal the deadlock process
 					op.sem_num = n;
 					op.sem_op = 1;
@@ -1050,1262 +612,452 @@ int main(int argc, char** argv) {
 					if (error == -1) {
 						fprintf(stderr, "\nsemop error(34) is: %s\n", strerror(errno));
 					}
+				}
 
-				} else if (icode == 4) {
-					// 4 is release
-					// send code and update time
-					time += 1;
-					processes[process_id].remaining_computation_time -= 1;
-					str_to_send = strdup("4 ");
-
-					// interpret the release instruction arguments into the string
-					// the string format is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_computation_time
-					tok = strtok(strdup(string), "(,);\n");
-					tok = strtok(NULL, "(,);\n");
-					idx = 0;
-					while (tok != NULL) {
-
-						// insert resource index
-						strcat(str_to_send, numb_to_string(idx));
-						strcat(str_to_send, strdup(" "));						
-
-						// insert number of resource of specific type
-						sscanf(tok, "%d", &n_of_names_resrc);
-						tok = strtok(NULL, "(,);\n");
-						strcat(str_to_send, numb_to_string(n_of_names_resrc));
-						strcat(str_to_send, strdup(" "));
-						
-						for (int j = 0; j < n_of_names_resrc; j++) {
-							strcat(str_to_send, strdup(pop_resource(processes[process_id].arr_allocated_resrcs, idx)));
-							strcat(str_to_send, strdup(" "));
+			} else if (icode == 4) {
+				// 4 is release
+				// update time
+				time += 1;
+				processes[process_id].remaining_computation_time -= 1;
+
+				// put the amount of every resource type in the shared state, since the commanding process reads all m
+				// of them, along with the IDs of the resources "popped"
+				for (int i = 0; i < m; i++) {
+					shared->amounts[i] = i < instr->n_args ? args[i] : 0;
+					int* ids = shared_ids(shared, i);
+					shared->n_ids[i] = 0;
+					for (int j = 0; j < shared->amounts[i]; j++) {
+						int id = pop_resource(processes[process_id].arr_allocated_resrcs, i);
+						if (id != -1) {
+							ids[shared->n_ids[i]++] = id;
 						}
-						idx++;
-					}
-					
-					// append time and remaining computation time to the end of the string
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-					// send the string to the commanding process
-					error = write((fd[n])[1], str_to_send, strlen(str_to_send));
-					if (error == -1) {
-						fprintf(stderr, "\nwrite(1) is: %s\n", strerror(errno));
-					}
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(35) is: %s\n", strerror(errno));
-					}
-
-					// wait for commanding process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(36) is: %s\n", strerror(errno));
-					}
-
-				} else if (icode == 5) {
-					// 5 is print_resources_used
-					// the format of the string is: 5 deadline_misses time remaining_comp_time
-
-					// print_resource_used takes a computation time
-					// the string sent is the code(5) and the current time
-					time += 1;
-					processes[process_id].remaining_computation_time -= 1;
-
-					str_to_send = strdup("5 ");
-
-					// put deadline misses
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].deadline_misses));
-
-					// append time to the end of the string
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-					
-					// send the string to the commanding process
-					error = write((fd[n])[1], str_to_send, strlen(str_to_send));
-					if (error == -1) {
-						fprintf(stderr, "\nwrite(1) is: %s\n", strerror(errno));
-					}
-
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(37) is: %s\n", strerror(errno));
-					}
-
-					// wait for commanding process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(38) is: %s\n", strerror(errno));
 					}
+				}
+				report(shared, process_id, 4, time, &processes[process_id]);
 
-					printf("\n%d -- Master string: %s\n\n\n", process_id + 1, print_master_string(&processes[process_id]));
-					printf("------------------------------------------------------\n\n");
+				// signal the commanding process to read
+				op.sem_num = n;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(35) is: %s\n", strerror(errno));
+				}
 
-					// send message to process to continue execution
-					// write((fd[n])[1], "9 ", strlen("9 "));
+				// wait for commanding process to signal to proceed
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(36) is: %s\n", strerror(errno));
+				}
 
+			} else if (icode == 5) {
+				// 5 is print_resources_used
 
-					// signal to deadlock process that child has read response
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(39) is: %s\n", strerror(errno));
-					}
+				// print_resource_used takes a computation time
+				time += 1;
+				processes[process_id].remaining_computation_time -= 1;
 
-					// finally, wait for the deadlock process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(40) is: %s\n", strerror(errno));
-					}
+				// the deadline misses go with the time
+				report(shared, process_id, 5, time, &processes[process_id]);
 
-				} else if (icode == 6) {
-					// 6 is end
-					// with end process, no computation time is taken, and all resources are released
-					str_to_send = strdup("6 ");
 
+				// signal the commanding process to read
+				op.sem_num = n;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(37) is: %s\n", strerror(errno));
+				}
 
-					// it is NOT the same thing as print_resource_used, but instead, more like a release
-					// the string format is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
+				// wait for commanding process to signal to proceed
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(38) is: %s\n", strerror(errno));
+				}
 
-					for (int i = 0; i < m; i++) {
-						// append the resource_type to the string
-						strcat(str_to_send, numb_to_string(i));
-						strcat(str_to_send, strdup(" "));
-						
-						int n_of_resrc = 0;
-						char* str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-						char* m_str = strdup(" ");
-						while (str != NULL) {
-							strcat(m_str, str);
-							strcat(m_str, strdup(" "));
-							str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-							n_of_resrc++;
-						}
-						
-						// apend number of the resource type to the string
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, numb_to_string(n_of_resrc));
-
-						// insert resource type
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, m_str);
-					}
+				if (print_master(&strings, &processes[process_id], words, process_id) == -1) {
+					end_child(shared, sid3, n, m, process_id, time, &processes[process_id], EXIT_FAILURE);
+				}
 
-					// append time and remaining computation time
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-					/*
-					if (process_id == 0) {
-						printf("string to send is: %s\n", str_to_send);
-					}*/
 
-					// send the string to the commanding process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
+				// signal to deadlock process that child has read response
+				op.sem_num = n;
+				op.sem_op = 1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(39) is: %s\n", strerror(errno));
+				}
 
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(41) is: %s\n", strerror(errno));
-					}
+				// finally, wait for the deadlock process to signal to proceed
+				op.sem_num = process_id;
+				op.sem_op = -1;
+				op.sem_flg = 0;
+				error = semop(sid3, &op, 1);
+				if (error == -1) {
+					fprintf(stderr, "\nsemop error(40) is: %s\n", strerror(errno));
+				}
 
-					exit(EXIT_SUCCESS);
-				} else {
-					// exit the process; however, print out an error and exit with FAILURE
+			} else {
+				// 6 is end
+				// with end process, no computation time is taken, and all resources are released
+				// anything else also ends the process; however, print out an error and exit with FAILURE
+				if (icode != 6) {
 					fprintf(stderr, "Wrong n returned\n");
-					
-					str_to_send = strdup("6 ");
-					// the string format is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-					for (int i = 0; i < m; i++) {
-						// append the resource_type to the string
-						strcat(str_to_send, numb_to_string(i));
-						strcat(str_to_send, strdup(" "));
-						
-						int n_of_resrc = 0;
-						char* str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-						char* m_str = strdup(" ");
-						while (str != NULL) {
-							strcat(m_str, str);
-							strcat(m_str, strdup(" "));
-							str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-							n_of_resrc++;
-						}
-						// apend number of the resource type to the string
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, numb_to_string(n_of_resrc));
+				}
+				end_child(shared, sid3, n, m, process_id, time, &processes[process_id], icode == 6 ? EXIT_SUCCESS : EXIT_FAILURE);
+			}
+			
+			if (advance) {
+				advance_instruction(instructions);
+			}
+			instr = next_instruction(instructions);
+		}
 
-						// insert resource type
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, m_str);
-					}
+		// process has finished executing all the strings
+		fprintf(stderr, "The process should have not gotten here\n");
+		exit(EXIT_FAILURE);
+	}
 
-					// append time and remaining computation time
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-					/*
-					if (process_id == 0) {
-						printf("string to send is: %s\n", str_to_send);
-					}*/
+	// report how often the last safe sequence was still safe, and how often the scheduler switched processes
+	print_safety_counters(stderr, (char*)name, bankers);
+	fprintf(stderr, "%s: %d context switches\n", name, context_switches);
 
-					// send the string to the commanding process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
+	destroy_arena(&strings);
+	unmap_shared_state(shared);
+}
 
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(42) is: %s\n", strerror(errno));
-					}
-					
+/*
+*	This program will simulate how the Banker's algorithm will allocate resources to processes.
+*	The algorithm will use the Earliest-Deadline-First scheduler (with Longest-Job-First as tie breaker) and 
+*	the Least-Laxity-First scheduler (with Shortest-Job-First as tie breaker).
+*
+*	Two different schedulers mean that two different outputs are given.
+*/
+int main(int argc, char** argv) {
+	/*
+	*   There is a single argument provided as input. It has two integers, m and n,
+	*   in the first two lines, signifying the number of resource types and the number
+	*   of processes respectively. While the assignment specifies two different input formats
+	*   developing the program to account for different formats is unnecessarily complicated.
+	*   Thus the next m and n*m lines are integers to be filled into the AVAILABLE array and MAX
+	*   matrix respectively.
+	* 
+	*   Afterwards, the following lines contain instructions to simulate how the processes will use
+	*   the resources.
+	* 
+	*   The output is the execution of the processes with the EDL scheduler and the LLF scheduler.
+	*	Since two different schedulers are used, output should reflect that
+	*
+	*	-a picks the safety algorithm of the Banker's algorithm (see set_safety_algorithm): passes, the default, or
+	*	sorted, which is faster when there are many processes.
+	*
+	*	-e picks the engine: event, the default, runs the simulation inside this process (see event_engine.h), and fork
+	*	runs every simulated process as a child process, passing the turn through semaphores and sharing the state of
+	*	the simulation through shared memory. Both print the same output.
+	*
+	*	-s picks the schedulers to run as a list like llf,edf (the default) of the names in scheduler.h. They run at the
+	*	same time, each from the state after the input was read (on a thread of its own with the event engine, and in a
+	*	process of its own with the fork engine), and each one keeps its output to itself until they are all done, when
+	*	it is printed in the order the schedulers were given.
+	*/
+	const char usage[] = "usage: %s [-a passes|sorted] [-e event|fork] [-s scheduler,...] <process_file> <word_file>\n";
+	int safety_algorithm = SAFETY_PASSES;
+	int fork_engine = FALSE;
+	int schedulers[N_SCHEDULERS] = {SCHEDULER_LLF, SCHEDULER_EDF};
+	int n_schedulers = 2;
+	int opt;
+	while ((opt = getopt(argc, argv, "a:e:s:")) != -1) {
+		if (opt == 'a' && strcmp(optarg, "passes") == 0) {
+			safety_algorithm = SAFETY_PASSES;
+		} else if (opt == 'a' && strcmp(optarg, "sorted") == 0) {
+			safety_algorithm = SAFETY_SORTED;
+		} else if (opt == 'e' && strcmp(optarg, "event") == 0) {
+			fork_engine = FALSE;
+		} else if (opt == 'e' && strcmp(optarg, "fork") == 0) {
+			fork_engine = TRUE;
+		} else if (opt == 's') {
+			n_schedulers = 0;
+			for (char* name = strtok(optarg, ","); name != NULL; name = strtok(NULL, ",")) {
+				int scheduler = find_scheduler(name);
+				if (scheduler == -1 || n_schedulers == N_SCHEDULERS) {
+					fprintf(stderr, usage, argv[0]);
 					exit(EXIT_FAILURE);
 				}
-				
-				string = deque_instruction(&processes[process_id].proc_instructions);
+				schedulers[n_schedulers++] = scheduler;
 			}
-
-			// process has finished executing all the strings
-			fprintf(stderr, "The process should have not gotten here\n");
+			if (n_schedulers == 0) {
+				fprintf(stderr, usage, argv[0]);
+				exit(EXIT_FAILURE);
+			}
+		} else {
+			fprintf(stderr, usage, argv[0]);
 			exit(EXIT_FAILURE);
 		}
+	}
+	if (argc - optind < 2) {
+		fprintf(stderr, usage, argv[0]);
+		exit(EXIT_FAILURE);
+	}
+	char* process_file = argv[optind];
+	char* word_file = argv[optind + 1];
 
+	int n, m;
+	FILE* input = fopen(process_file, "r");
 
+	/*
+	*   If the files are not provided, exit the program
+	*/
+	if (input == NULL) {
+		printf("The file is null\n");
+		exit(EXIT_FAILURE);
+	}
 
+	/*
+	*	The lines will not exceed 1000 characters, so allocate 1000 characters as a buffer.
+	*	Read the first two integers, initialize the AVAILABLE and MAX data structures, as well as
+	*   any other data structures necessary, and then read the next line.
+	*/
+	size_t len = 1000;
+	char line[len];
+	char sec_line[len];
+	fgets(line, len, input);
+	sscanf(line, "%d", &m);
+	fgets(line, len, input);
+	sscanf(line, "%d", &n);
 
+	/*
+	*	MAX and AVAILABLE are not stored within the process/resource data structure for ease of the 
+	*	safety algorithm
+	*
+	*	RESOURCES is an array of stacks not allocated to any process. When a process requests a specific resource,
+	*	it will go to the stack at the specified index and pop the top, pushing it to the RESOURCE stack held by the process.
+	*	It's important for the m to match the number of resources inside the sample_words.txt. Otherwise, there will be errors.
+	*
+	*	FINISH is an array that indicates whether process at an index is finished
+	*
+	*	AVAILABLE, MAX, ALLOCATION, NEED and FINISH are all in the one block of the Banker's state (see bankers.h),
+	*	and MAX, ALLOCATION and NEED are indexed as [i * m + j] for process i and resource type j.
+	*/
+	struct bankers bankers;
+	if (init_bankers(&bankers, n, m) == -1 || set_safety_algorithm(&bankers, safety_algorithm) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	int* available = bankers.available;
+	int* max = bankers.max;
+	struct process* processes = (struct process*)malloc(sizeof(struct process) * n);
+	struct resource_stack* resources = (struct resource_stack*)calloc(m, sizeof(struct resource_stack));
 
 
+	for (int i = 0; i < n; i++) {
+		init_instructions(&processes[i].proc_instructions);
+		init_master_string(&processes[i].master);
+		processes[i].state = CREATED;
+		processes[i].deadline_misses = 0;
 
-		// free the file descriptors
-		for (int i = 0; i <= n; i++) {
-			free(fd[i]);
-		}
-		free(fd);
-
-		/*
-		op.sem_num = 0;
-		op.sem_op = 1;
-		op.sem_flg = 0;
-		error = semop(sid1, &op, 1);
-		if (error == -1) {
-			fprintf(stderr, "\nsemop error(19) is: %s\n", strerror(errno));
-		}
-		*/
-
-	} else {
-
-		// execute EDL and LLF seperatly
-		/*
-		op.sem_num = 0;	// the last semaphore
-		op.sem_op = -1;
-		op.sem_flg = 0;
-		int error = semop(sid1, &op, 1);
-		if (error == -1) {
-			fprintf(stderr, "\nsemop error(20) is: %s\n", strerror(errno));
-		}*/
-
-		printf("=======================================\nBANKER'S ALGORITHM WITH LLF SCHEDULING\n=======================================\n");
-		/*
-		*	The key difference which distinguishes the LLF scheduler from the EDL scheduler is that after each instruction, the deadlock process
-		*	must check if a context switch must occur.
-		*/
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-		// create n + 1 file descriptors, one for each child process, and one for deadlock process
-		int** fd = (int**)malloc(sizeof(int) * (n + 1));
-		for (int i = 0; i <= n; i++) {
-			fd[i] = (int*)malloc(sizeof(int) * 2);
-			pipe(fd[i]);
-		}
-
-		// Create n child processes
-		int process_id = n;
-		int tpid = 1;
-		for (int i = 0; i < n; i++) {
-			if (tpid) {
-				tpid = fork();
-				if (!tpid) {
-					process_id = i;
-				}
-			}
+		processes[i].arr_allocated_resrcs = (struct resource_stack*)calloc(m, sizeof(struct resource_stack));
+		processes[i].request_array = (int*)malloc(sizeof(int) * m);
+		for (int j = 0; j < m; j++) {
+			processes[i].request_array[j] = 0;
 		}
+ 	}
 
-		/*
-		*	The commanding process (or deadlock process) computes if the system is in a safe state, and if it is, it finds out which process to
-		*	give priority to and sends a signal to the child process (through semaphore operations) to proceed with computation along with information
-		*	contained in a pipe. The child processes reads the info that the parent process sends through the pipe, and proceeds until the end is reached
-		*	or a "request" or "release" function is called. If the child process sends a request but the request puts the system in a safe state, then the parent
-		*	process will not allow for the child process to proceed until it is free.
-		*
-		*	Since this fork uses the LLF scheduler with SJF as tie-breaker, the commanding process needs to send info about the time when it pipes information.
-		*/
-		// get the values of the semaphore
-		int time;
-		int instr_time;
-		int safe;
-		if (process_id == n) {
-			// loop until all processes have finished
-			// the time is given by the commanding (deadlock) process
-			time = 0;
-			int all_finished = FALSE;
-			
-			while (!all_finished) {
-
-				// first check if there is any waiting state that can proceed if request can be satisfied
-				int idx = -1;
-				for (int i = 0; i < n; i++) {
-					if (processes[i].state == WAITING) {
-						safe = TRUE;
-						for (int j = 0; j < m; j++) {
-							if (available[j] < processes[i].request_array[j]) {
-								safe = FALSE;
-							}
-							available[i] = available[i] - processes[i].request_array[j];
-						}
-						safe = safe && safe_state(n, m, available, max, allocation, finish);
-
-						if (safe) {
-							processes[i].state = READY;
-							idx = i;
-						}
-						for (int j = 0; j < m; j++) {
-							available[i] = available[i] + processes[i].request_array[j];
-						}
-					} else {
-						idx = i;
-					}
-				}
-
-				// then find the process with the lowest laxity that is not finished and can be executed without putting the system in an unsafe state
-				// set all_finished to be true; if there is a process that has not finished execution, set it to false
-				int low_lax = 100000;
-				all_finished = TRUE;
-				for (int i = 0; i < n; i++) {
-					if (!finish[i]) {
-						int curr_lax = processes[i].deadline - time - processes[i].remaining_computation_time;
-						if (idx == -1) {
-							idx = i;
-							low_lax = curr_lax;
-						}
-						//printf("process %d state is [%d] and lax is [%d - %d - %d = %d]\n", i, processes[i].state, processes[i].deadline, time, processes[i].remaining_computation_time, curr_lax);
-
-						if (processes[i].state != WAITING && processes[i].state != REQUESTED) {
-							if (curr_lax < low_lax) {
-								idx = i;
-								low_lax = curr_lax;
-							} else if ((curr_lax == low_lax) &&  (processes[i].computation_time < processes[idx].computation_time)) {
-								idx = i;
-								low_lax = curr_lax;
-							}
-							all_finished = FALSE;
-						}
-					}
-				}
-
-
-				// next, change all processes with a state of REQUESTED to a state of READY
-				// if all_finished is TRUE, then rereun the banker's algorithm so that
-				for (int i = 0; i < n; i++) {
-					if (!finish[i]) {
-						if (processes[i].state == REQUESTED) {
-							processes[i].state = READY;
-							if (all_finished) {
-								int curr_lax = processes[i].deadline - time - processes[i].remaining_computation_time;
-
-								if (idx == -1) {
-									idx = i;
-									low_lax = curr_lax;
-								}
-
-								if (curr_lax < low_lax) {
-									idx = i;
-									curr_lax = low_lax;
-								} else if ((curr_lax == low_lax) &&  (processes[i].computation_time < processes[idx].computation_time)) {
-									idx = i;
-									curr_lax = low_lax;
-								}
-							}
-						}
-					}
-				}
-
-
-				if (!all_finished) {
-					// clear out everything in line
-					memset(line, 0, len);
-
-
-					// write the time to the code
-					write((fd[idx])[1], numb_to_string(time), strlen(numb_to_string(time)));
-					write((fd[idx])[1], "  ", strlen("  "));
-					processes[idx].state = RUNNING;
-
-					// signal chosen semaphore operation to execute code
-					op.sem_num = idx;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(21) is: %s\n", strerror(errno));
-					}
-
-					// child process will execute an instruction, so wait for it to signal
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(22) is: %s\n", strerror(errno));
-					}
-				} else {
-					// if the code is finished, write code 9 so that program doesn't hang on read
-					write((fd[n])[1], "9 ", strlen("9 "));
-				}
-
-				// once the child process has finished executing an instruction
-				// it will send a message along the pipe
-
-				// the child process will send back a request, a release, or an end
-				// read from the pipe dedicated for command process
-				error = read((fd[process_id])[0], line, len);
-				if (error == -1) {
-					fprintf(stderr, "\nread error is: %s\n", strerror(errno));
-				}
-
-				//printf("From child process(%d): %s\n", idx, line);
-
-				// the first integer in the line gives the code
-				int code;
-				char* tok = strtok(strdup(line), " \n");
-				sscanf(tok, "%d", &code);
-				
-
-				// after getting the code of the message, we can determine the instruction the code ran
-				if (code == 1) {
-					// code returned is 1
-					// the instruction executed is calculate
-					// the format of the string is: code time remaining_comp_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-				} else if (code == 2) {
-					// the child process is requesting resources
-					// the format of the string is: code resrc_#1 resrc_#2 ... resrc_#m time remaining_comp_time
-
-					// make sure that the process isn't requesting more resources than available
-					int negative_resrcs = FALSE;
-					for (int i = 0; i < m; i++) {
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &processes[idx].request_array[i]);
-
-						// subtract the request from available and add to allocation
-						available[i] = available[i] - processes[idx].request_array[i];
-						if (available[i] < 0)
-							negative_resrcs = TRUE;
-						(allocation[idx])[i] = (allocation[idx])[i] + processes[idx].request_array[i];
-					}
-
-					// read the time and the remaining computation time of the process
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-					
-
-					// if this puts the system into an unsafe state, then revert the changes
-					// and wait for the resources to become available
-					int status_code;
-					char* str_to_send = strdup("");
-					if (negative_resrcs || !safe_state(n, m, available, max, allocation, finish)) {
-						for (int i = 0; i < m; i++) {
-							available[i] = available[i] + processes[idx].request_array[i];
-							(allocation[idx])[i] = (allocation[idx])[i] - processes[idx].request_array[i];
-						}
-
-						processes[idx].state = WAITING;
-
-						// sent this status code to the child process to indicate that the process will need to wait
-						// and resubmit the string again at a later time
-						status_code = 1;
-						strcat(str_to_send, strdup("1 "));
-					} else {
-						// once the request is satisfied, the process must wait (as per assignment specifications) until
-						// another process makes a request or finishes running. if no other processes makes a request, then continue
-						processes[idx].state = REQUESTED;
-
-						// send this status code to the child process to tell that it to read the pipe to get the resources it wants
-						status_code = 0;
-						strcat(str_to_send, strdup("0 "));
-
-						// then send the request names in the format: status_code resrc_idx1 #_req_resrc_1 resrc_1_name_1 ... #_req_resrc_2 resrc_2_name_1 ... ... #_req_resrc_m resrc_m_name_1 ... 
-						for (int i = 0; i < m; i++) {
-							strcat(str_to_send, numb_to_string(i));
-							strcat(str_to_send, strdup(" "));
-							strcat(str_to_send, numb_to_string(processes[idx].request_array[i]));
-							strcat(str_to_send, strdup(" "));
-							
-							for (int j = 0; j < processes[idx].request_array[i]; j++) {
-								strcat(str_to_send, pop_resource(resources, i));
-								strcat(str_to_send, strdup(" "));
-							}
-						}
-						//printf("string: %s\n", str_to_send);
-						//printf("request value: ");
-					}
-
-					printf("State of the system:\n");
-					// print state of system
-					printf("available = ");
-					for (int i = 0; i < m; i++) {
-						printf("%d ", available[i]);
-					}
-					printf("\n");
-					printf("max[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j]);
-					}
-					printf("\n");
-					printf("allocation[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("need[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j] - (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("deadline_misses[%d] = %d\n\n", idx+1, processes[process_id].deadline_misses);
-
-
-					// write response to child process
-					write((fd[idx])[1], str_to_send, strlen(str_to_send));
-
-					// signal the requesting process semaphore operation to execute code
-					op.sem_num = idx;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(23) is: %s\n", strerror(errno));
-					}
-
-					// wait for the requesting process to interpret the message sent
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(24) is: %s\n", strerror(errno));
-					}
-
-				} else if (code == 3) {
-					// code returned is 3
-					// the instruction executed is use_resources
-					// the format of the string is: code time remaining_comp_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-				} else if (code == 4) {
-					// if code is 4, the code is releasing resources
-
-					// the child process returns a string of all the resources it has "popped"
-					// the format of the string is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-					for (int i = 0; i < m; i++) {
-						// read the resource index and number of resources released
-						int resrc_idx, n_of_resrc;
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &resrc_idx);
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &n_of_resrc);
-						available[i] = available[i] + n_of_resrc;
-						(allocation[idx])[i] = (allocation[idx])[i] - n_of_resrc;
-
-						// get the names of all the resources and push them back onto the stack
-						for (int j = 0; j < n_of_resrc; j++) {
-							tok = strtok(NULL, " ");
-							push_resource(resources, tok, resrc_idx);
-						}
-					}
-
-					// get the time and remaining_computation_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-
-					// there is no need to signal the code since the released resources might allow for previously waiting
-					// processes to continue
-
-				} else if (code == 5) {
-					// if code is 5, print the resources used so far
-					// the format of the string is: code deadline_misses time remaining_comp_time
-					
-					printf("State of the system:\n");
-					// print state of system
-					printf("available = ");
-					for (int i = 0; i < m; i++) {
-						printf("%d ", available[i]);
-					}
-					printf("\n");
-					printf("max[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j]);
-					}
-					printf("\n");
-					printf("allocation[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("need[%d] = ", idx+1);
-					for (int j = 0; j < m; j++) {
-						printf("%d ", (max[idx])[j] - (allocation[idx])[j]);
-					}
-					printf("\n");
-					printf("deadline_misses[%d] = %d\n\n", idx+1, processes[process_id].deadline_misses);
-					
-					// get deadline misses, time, and remaining computation time
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &processes[idx].deadline_misses);
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " ");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-					
-					printf("deadline misses = %d\n", processes[idx].deadline_misses);
-
-
-					// signal to child process that deadlock process has recieved print instructions
-					op.sem_num = idx;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(25) is: %s\n", strerror(errno));
-					}
-
-					// wait for child process to print master string
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(26) is: %s\n", strerror(errno));
-					}
-				} else if (code == 6) {
-					// if code is 6, then the process has finished execution
-					// it functions like a release
-
-					// the child process returns a string of all the resources it has "popped"
-					// the format of the string is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-					for (int i = 0; i < m; i++) {
-						// read the resource index and number of resources released
-						int resrc_idx, n_of_resrc;
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &resrc_idx);
-						tok = strtok(NULL, " ");
-						sscanf(tok, "%d", &n_of_resrc);
-
-						// get the names of all the resources and push them back onto the stack
-						for (int j = 0; j < n_of_resrc; j++) {
-							tok = strtok(NULL, " ");
-							push_resource(resources, tok, resrc_idx);
-						}
-					}
-
-					// get the time and remaining_computation_time
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &time);
-					tok = strtok(NULL, " \n");
-					sscanf(tok, "%d", &processes[idx].remaining_computation_time);
-
-					finish[idx] = TRUE;
-					
-				} else if (code == 9) {
-					// this code is sent if everything has finished
-				} else {
-					fprintf(stderr, "how did we get here?\nThe string in the pipe: %s\n", line);
-				}
-				
-				// check if all is finished
-				all_finished = TRUE;
-				for (int i = 0; i < n; i++) {
-					all_finished = all_finished && finish[i];
-				}
-
-			}
-		} else {
-			// in child process, wait until deadlock process allows to proceed
-			op.sem_num = process_id;
-			op.sem_op = -1;
-			op.sem_flg = 0;
-			error = semop(sid3, &op, 1);
-			if (error == -1) {
-				fprintf(stderr, "\nsemop error(27) is: %s\n", strerror(errno));
-			}
-
-			char* string = deque_instruction(&processes[process_id].proc_instructions);
-			while (string != NULL) {
 
-				// read the current time from the pipe
-				read((fd[process_id])[0], line, len);
-				sscanf(line, "%d", &time);
+	for (int i = 0; i < m; i++) {
+		fscanf(input, "%d", &available[i]);
+	}
+	for (int i = 0; i < n; i++) {
+		for (int j = 0; j < m; j++) {
+			fscanf(input, "%d", &max[i * m + j]);
+		}
+	}
+	compute_need(&bankers);
 
-				int icode = parse_instruction(string);
+	/*
+	*	The remaining lines in the file are the processes, their deadline and computation time,
+	*	and their instructions. First read the process line; the next two lines indicate deadline,
+	*	and computation time. The following lines are instructions that the process should execute as
+	*	well as an instruction to print the resources used up so far. Finally, the last instruction
+	*/
+	int proc_count = 0;
+	while (!feof(input)) {
+		fgets(line, len, input);
+		strncpy(sec_line, line, strlen("process"));
+		if (strcmp("process", sec_line) == 0) {
+			// we have the start to a process
+			// the next two lines give the deadline and computation time
+			processes[proc_count].proc_id = proc_count;
+			fgets(line, len, input);
+			sscanf(line, "%d", &processes[proc_count].deadline);
+			fgets(line, len, input);
+			sscanf(line, "%d", &processes[proc_count].computation_time);
+			processes[proc_count].remaining_computation_time = processes[proc_count].computation_time;
 
-				// check if any deadline misses occurred
-				if (time > processes[process_id].deadline) {
-					processes[process_id].deadline_misses++;
+			int terminate = (1 == 0);
+			while (!feof(input) && !terminate) {
+				fgets(line, len, input);
+				strcpy(sec_line, line);
+				if (strcmp("end.\n", sec_line) == 0) {
+					terminate = (1 == 1);
 				}
-
-				// storing all previous declarations so that the gcc doesn't throw a fit
-				int n_of_names_resrc = -1;
-				char* tok;
-				char* str_to_send;
-				int idx;
-				int status_code;
-
-				if (icode == 1) {
-					// 1 is calculate
-					sscanf(string, "calculate(%d)", &instr_time);
-					time += instr_time;
-					processes[process_id].remaining_computation_time -= instr_time;
-
-					// the format of the string is: code time remaining_comp_time
-					str_to_send = strdup("1 ");
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-					// send the message to deadlock process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
-					
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(28) is: %s\n", strerror(errno));
-					}
-
-					// wait for commanding process to send the status code
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(30) is: %s\n", strerror(errno));
-					}
-
-				} else if (icode == 2) {
-					// 2 is request
-					// the assignment demands that after each request, print the state of the process
-					
-					// the request instruction takes 1 computation time
-					time += 1;
-					processes[process_id].remaining_computation_time -= 1;
-
-					// the format of the string is: code resrc_#1 resrc_#2 ... resrc_#m time remaining_comp_time
-					str_to_send = strdup("2 ");
-
-					// load the request array into the string
-					tok = strtok(strdup(string), "(,);\n");
-					tok = strtok(NULL, "(,);\n");
-					idx = 0;
-					while (tok != NULL) {
-						sscanf(tok, "%d", &processes[process_id].request_array[idx]);
-						tok = strtok(NULL, "(,);\n");
-						strcat(str_to_send, numb_to_string(processes[process_id].request_array[idx++]));
-					}
-					// append time and remaining_comp_time to the end of the string
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-					// send the string to the commanding process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(29) is: %s\n", strerror(errno));
-					}
-					
-					// wait for commanding process to send the status code
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(30) is: %s\n", strerror(errno));
-					}
-
-					// once the commanding process has allowed for the process to proceed
-					// read what the commanding process has sent through the pipe
-					read((fd[process_id])[0], line, len);
-
-
-					// get the status code
-					tok = strtok(line, " (,);\n");
-					sscanf(tok, "%d", &status_code);
-
-					
-					if (status_code == 0) {
-						// the string format is: resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... 
-						int resrc_idx, n_of_names_resrc;
-
-						char req_word[20];
-						for (int i = 0; i < m; i++) {
-							tok = strtok(NULL, " (,);\n");
-							sscanf(tok, "%d", &resrc_idx);
-
-							tok = strtok(NULL, " (,);\n");
-							sscanf(tok, "%d", &n_of_names_resrc);
-
-							for (int j = 0; j < n_of_names_resrc; j++) {
-								tok = strtok(NULL, " (,);\n");
-								sscanf(tok, "%s", req_word);
-								push_resource(processes[process_id].arr_allocated_resrcs, req_word, resrc_idx);
-							}
-						}
-
-					} else if (status_code == 1) {
-						// store the previous string instruction
-						struct instruction* temp = processes[process_id].proc_instructions;
-						struct instruction* new_head = (struct instruction*)malloc(sizeof(struct instruction));
-						new_head->instruction = strdup(string);
-						new_head->next_instruction = temp;
-						processes[process_id].proc_instructions = new_head;
-
-						// increment the computation time
-						processes[process_id].remaining_computation_time++; 
-					} else {
-						printf("WHAT HAS HAPPENED HERE\n");
-					}
-
-					printf("\n%d -- Master string: %s\n\n\n", process_id + 1, print_master_string(&processes[process_id]));
-					printf("------------------------------------------------------\n\n");
-
-					// send message to process to continue execution
-					// write((fd[n])[1], "9 ", strlen("9 "));
-
-
-					// signal to deadlock process that child has read response
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(31) is: %s\n", strerror(errno));
-					}
-
-					// finally, wait for the deadlock process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(32) is: %s\n", strerror(errno));
-					}
-
-				} else if (icode == 3) {
-					// 3 is use_resource
-					int y;
-					sscanf(string, "use_resources(%d,%d)", &instr_time, &y);
-					struct resources* temp = NULL;
-					char* t_str;
-					for (int i = 0; i < m; i++) {
-						struct resource* temp = (processes[process_id].arr_allocated_resrcs[i]);
-						for (int j = 0; j < y && temp != NULL; j++) {
-							t_str = temp->resource_name;
-							strcat(processes[process_id].master_str, strdup(" "));
-							strcat(processes[process_id].master_str, strdup(t_str));	//append to master string
-							temp = temp->next_resource;
-							processes[process_id].n_str_master++;
-						}
-					}
-					time += instr_time;
-					processes[process_id].remaining_computation_time -= instr_time;
-
-					// the format of the string is: code time remaining_comp_time
-					str_to_send = strdup("3 ");
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-
-					// send the string to the commanding process
-					error = write((fd[n])[1], str_to_send, strlen(str_to_send));
-					if (error == -1) {
-						fprintf(stderr, "\nwrite(1) is: %s\n", strerror(errno));
-					}
-					
-					// signal the deadlock process
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(33) is: %s\n", strerror(errno));
-					}
-
-					// finally, wait for the deadlock process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(34) is: %s\n", strerror(errno));
-					}
-
-				} else if (icode == 4) {
-					// 4 is release
-					// send code and update time
-					time += 1;
-					processes[process_id].remaining_computation_time -= 1;
-					str_to_send = strdup("4 ");
-
-					// interpret the release instruction arguments into the string
-					// the string format is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_computation_time
-					tok = strtok(strdup(string), "(,);\n");
-					tok = strtok(NULL, "(,);\n");
-					idx = 0;
-					while (tok != NULL) {
-
-						// insert resource index
-						strcat(str_to_send, numb_to_string(idx));
-						strcat(str_to_send, strdup(" "));						
-
-						// insert number of resource of specific type
-						sscanf(tok, "%d", &n_of_names_resrc);
-						tok = strtok(NULL, "(,);\n");
-						strcat(str_to_send, numb_to_string(n_of_names_resrc));
-						strcat(str_to_send, strdup(" "));
-						
-						for (int j = 0; j < n_of_names_resrc; j++) {
-							strcat(str_to_send, strdup(pop_resource(processes[process_id].arr_allocated_resrcs, idx)));
-							strcat(str_to_send, strdup(" "));
-						}
-						idx++;
-					}
-					
-					// append time and remaining computation time to the end of the string
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-
-					// send the string to the commanding process
-					error = write((fd[n])[1], str_to_send, strlen(str_to_send));
-					if (error == -1) {
-						fprintf(stderr, "\nwrite(1) is: %s\n", strerror(errno));
-					}
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(35) is: %s\n", strerror(errno));
-					}
-
-					// wait for commanding process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(36) is: %s\n", strerror(errno));
-					}
-
-				} else if (icode == 5) {
-					// 5 is print_resources_used
-					// the format of the string is: 5 deadline_misses time remaining_comp_time
-
-					// print_resource_used takes a computation time
-					// the string sent is the code(5) and the current time
-					time += 1;
-					processes[process_id].remaining_computation_time -= 1;
-
-					str_to_send = strdup("5 ");
-
-					// put deadline misses
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].deadline_misses));
-
-					// append time to the end of the string
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-					
-					// send the string to the commanding process
-					error = write((fd[n])[1], str_to_send, strlen(str_to_send));
-					if (error == -1) {
-						fprintf(stderr, "\nwrite(1) is: %s\n", strerror(errno));
-					}
-
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(37) is: %s\n", strerror(errno));
-					}
-
-					// wait for commanding process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(38) is: %s\n", strerror(errno));
-					}
-
-					printf("\n%d -- Master string: %s\n\n\n", process_id + 1, print_master_string(&processes[process_id]));
-					printf("------------------------------------------------------\n\n");
-
-					// send message to process to continue execution
-					// write((fd[n])[1], "9 ", strlen("9 "));
-
-
-					// signal to deadlock process that child has read response
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(39) is: %s\n", strerror(errno));
-					}
-
-					// finally, wait for the deadlock process to signal to proceed
-					op.sem_num = process_id;
-					op.sem_op = -1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(40) is: %s\n", strerror(errno));
-					}
-
-				} else if (icode == 6) {
-					// 6 is end
-					// with end process, no computation time is taken, and all resources are released
-					str_to_send = strdup("6 ");
-
-
-					// it is NOT the same thing as print_resource_used, but instead, more like a release
-					// the string format is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-
-					for (int i = 0; i < m; i++) {
-						// append the resource_type to the string
-						strcat(str_to_send, numb_to_string(i));
-						strcat(str_to_send, strdup(" "));
-						
-						int n_of_resrc = 0;
-						char* str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-						char* m_str = strdup(" ");
-						while (str != NULL) {
-							strcat(m_str, str);
-							strcat(m_str, strdup(" "));
-							str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-							n_of_resrc++;
-						}
-						// apend number of the resource type to the string
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, numb_to_string(n_of_resrc));
-
-						// insert resource type
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, m_str);
-					}
-
-					// append time and remaining computation time
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-					/*
-					if (process_id == 0) {
-						printf("string to send is: %s\n", str_to_send);
-					}*/
-
-					// send the string to the commanding process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
-
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(41) is: %s\n", strerror(errno));
-					}
-
-					exit(EXIT_SUCCESS);
-				} else {
-					// exit the process; however, print out an error and exit with FAILURE
-					fprintf(stderr, "Wrong n returned\n");
-					
-					str_to_send = strdup("6 ");
-					// the string format is: code resrc_idx1 #_of_names_resrc_1 resrc_id1_name1 resrc_id1_name2 ... resrc_idx2 #_of_names_resrc_2 resrc_id2_name1 resrc_id2_name2 ... ... time remaining_comp_time
-					for (int i = 0; i < m; i++) {
-						// append the resource_type to the string
-						strcat(str_to_send, numb_to_string(i));
-						strcat(str_to_send, strdup(" "));
-						
-						int n_of_resrc = 0;
-						char* str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-						char* m_str = strdup(" ");
-						while (str != NULL) {
-							strcat(m_str, str);
-							strcat(m_str, strdup(" "));
-							str = pop_resource(processes[process_id].arr_allocated_resrcs, i);
-							n_of_resrc++;
-						}
-						// apend number of the resource type to the string
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, numb_to_string(n_of_resrc));
-
-						// insert resource type
-						strcat(str_to_send, strdup(" "));
-						strcat(str_to_send, m_str);
-					}
-
-					// append time and remaining computation time
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(time));
-					strcat(str_to_send, strdup(" "));
-					strcat(str_to_send, numb_to_string(processes[process_id].remaining_computation_time));
-					/*
-					if (process_id == 0) {
-						printf("string to send is: %s\n", str_to_send);
-					}*/
-
-					// send the string to the commanding process
-					write((fd[n])[1], str_to_send, strlen(str_to_send));
-
-					// signal the commanding process to read
-					op.sem_num = n;
-					op.sem_op = 1;
-					op.sem_flg = 0;
-					error = semop(sid3, &op, 1);
-					if (error == -1) {
-						fprintf(stderr, "\nsemop error(42) is: %s\n", strerror(errno));
-					}
-					
+				// decode the instruction and store it in the list
+				if (add_instruction(&processes[proc_count].proc_instructions, line) == -1) {
 					exit(EXIT_FAILURE);
 				}
-
-				string = deque_instruction(&processes[process_id].proc_instructions);
+				memset(sec_line, 0, sizeof(sec_line));				
 			}
-
-			// process has finished executing all the strings
-			fprintf(stderr, "The process should have not gotten here\n");
-			exit(EXIT_FAILURE);
+			proc_count++;
 		}
+		memset(sec_line, 0, sizeof(sec_line));
+	}
+	fclose(input);
 
+	input = fopen(word_file, "r");
+	
+	/*
+	*   If the file is not provided, exit the program
+	*/
+	if (input == NULL) {
+		printf("The file is null\n");
+		exit(EXIT_FAILURE);
+	}
 
+	// read the resource name and type
+	// somwhere in here, max freaks out
+	// every name is interned in words, and the stacks hold its ID
+	struct word_table words;
+	if (init_word_table(&words) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	int ridx = 0;
+	while (!feof(input)) {
+		fgets(line, len, input);
+		char* tok = strtok(line, ": ,");
+		tok = strtok(NULL, ": ,");
+		tok = strtok(NULL, ": ,");
+		// the last line is read again at the end of the file, and there is no stack for it
+		while (tok != NULL && ridx < m) {
+			// a name is only what comes before a space, parenthesis, comma, semicolon or newline, which is what the
+			// children used to get when the name went through a pipe (the last name of a line still has its newline)
+			char* start = tok + strspn(tok, " (,);\n");
+			start[strcspn(start, " (,);\n\t\r\v\f")] = '\0';
+			int id = intern_word(&words, start);
+			if (id == -1) {
+				exit(EXIT_FAILURE);
+			}
+			push_resource(resources, id, ridx);
+			tok = strtok(NULL, ": ,\n");
+		}
+		ridx++;
+	}
+	fclose(input);
+	if (rank_words(&words) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	memset(line, 0, sizeof(line));
 
+	/*
+	*	The event engine runs the schedulers at the same time on threads of this process, each from the state after the
+	*	input was read, and prints their output in the order they were given.
+	*/
+	if (!fork_engine) {
+		int result = run_event_engines(schedulers, n_schedulers, n, m, &bankers, processes, resources, &words);
+		for (int i = 0; i < n; i++) {
+			free(processes[i].request_array);
+			free_instructions(&processes[i].proc_instructions);
+		}
+		destroy_bankers(&bankers);
+		destroy_word_table(&words);
+		exit(result == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+	}
 
+	/*
+	*	Fork a process for every scheduler, so that each one has its own copy of the processes and instructions, and
+	*	they all run at the same time. Each one writes its output and errors to files of its own, which its simulated
+	*	processes share with it, and once every scheduler is done the files are printed in the order the schedulers
+	*	were given.
+	*/
+	FILE** outputs = (FILE**)malloc(sizeof(FILE*) * n_schedulers);
+	FILE** errors = (FILE**)malloc(sizeof(FILE*) * n_schedulers);
+	for (int k = 0; k < n_schedulers; k++) {
+		outputs[k] = tmpfile();
+		errors[k] = tmpfile();
+		if (outputs[k] == NULL || errors[k] == NULL) {
+			fprintf(stderr, "could not create the output files of the schedulers: %s\n", strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+	}
+	fflush(stdout);
+	fflush(stderr);
+	for (int k = 0; k < n_schedulers; k++) {
+		if (fork() == 0) {
+			dup2(fileno(outputs[k]), STDOUT_FILENO);
+			dup2(fileno(errors[k]), STDERR_FILENO);
+			// the commanding process and the children take turns writing to the same file, so nothing can wait in a buffer
+			setvbuf(stdout, NULL, _IONBF, 0);
+
+			/*
+			*	create n + 1 semaphores, one for each child process, and one for deadlock process.
+			*	parent process has process_id = n, so the semaphore corresponding to it is semaphore @ n.
+			*	Every scheduler has a set of its own, so that they do not get in the way of each other.
+			*/
+			int sid3 = semget(IPC_PRIVATE, n + 1, 0600 | IPC_CREAT);
+			if (sid3 == -1) {
+				fprintf(stderr, "semget failed: %s\n", strerror(errno));
+				exit(EXIT_FAILURE);
+			}
 
+			run_fork_engine(schedulers[k], n, m, &bankers, processes, resources, &words, sid3);
 
+			// wait for the simulated processes to exit before their semaphores are removed
+			while (wait(NULL) > 0) {
+			}
+			semctl(sid3, 0, IPC_RMID, 0);
 
-
-
-
-
-		// free the file descriptors
-		for (int i = 0; i <= n; i++) {
-			free(fd[i]);
+			for (int i = 0; i < n; i++) {
+				free(processes[i].request_array);
+				free_instructions(&processes[i].proc_instructions);
+			}
+			destroy_bankers(&bankers);
+			destroy_word_table(&words);
+			exit(EXIT_SUCCESS);
 		}
-		free(fd);
+	}
 
-		op.sem_num = 0;
-		op.sem_op = 1;
-		op.sem_flg = 0;
-		error = semop(sid1, &op, 1);
-		if (error == -1) {
-			fprintf(stderr, "\nsemop error(43) is: %s\n", strerror(errno));
+	// wait for every scheduler to finish, then print what each one wrote
+	for (int k = 0; k < n_schedulers; k++) {
+		wait(NULL);
+	}
+	char buffer[4096];
+	for (int k = 0; k < n_schedulers; k++) {
+		size_t n_read;
+		rewind(outputs[k]);
+		while ((n_read = fread(buffer, 1, sizeof(buffer), outputs[k])) > 0) {
+			fwrite(buffer, 1, n_read, stdout);
 		}
-
-		for (int i = 0; i < n; i++) {
-			free(max[i]);
-			free(allocation[i]);
-			free(processes[i].request_array);
+		fflush(stdout);
+		rewind(errors[k]);
+		while ((n_read = fread(buffer, 1, sizeof(buffer), errors[k])) > 0) {
+			fwrite(buffer, 1, n_read, stderr);
 		}
-		free(max);
-		free(available);
-		free(allocation);
-
-		exit(EXIT_SUCCESS);
-
+		fclose(outputs[k]);
+		fclose(errors[k]);
 	}
-	semctl(sid1, 0, IPC_RMID, 0);
-	semctl(sid3, 0, IPC_RMID, 0);
+	free(outputs);
+	free(errors);
+	for (int i = 0; i < n; i++) {
+		free(processes[i].request_array);
+		free_instructions(&processes[i].proc_instructions);
+	}
+	destroy_bankers(&bankers);
+	destroy_word_table(&words);
 	exit(EXIT_SUCCESS);
 
 }
-
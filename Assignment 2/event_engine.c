@@ -0,0 +1,543 @@
+/*
+*	The discrete-event engine runs the simulation of the Banker's algorithm in a single process. The fork engine in
+*	deadlock_avoidance.c has a commanding process pick the next process to run, and a child for every simulated
+*	process that runs one instruction at a time and answers through memory shared with it, with semaphores passing the
+*	turn back and forth. Here picking a process is a function call, and running its next instruction is another, so a
+*	round trip costs no system calls at all.
+*
+*	What the commanding process and the children each know is kept apart where the output depends on it: the
+*	commanding process only learns the time and the remaining computation time of a process when its child hands the
+*	turn back.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "word_table.h"
+#include "arena.h"
+#include "simple_process.h"
+#include "bankers.h"
+#include "ready_queue.h"
+#include "scheduler.h"
+#include "wait_lists.h"
+#include "event_engine.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	processes holds what the commanding process knows about every simulated process, along with what its child keeps
+*	for itself (its resources, master string, deadline misses and the place in its instructions). remaining[i] is the
+*	remaining computation time the child of process i counts: when a request has to wait, the child gives back the time
+*	unit of the request, but the commanding process only sees it the next time the child hands the turn back.
+*
+*	scheduling holds the processes the scheduler can pick from: the ones that have not finished and are neither waiting
+*	nor just given a request. requested is the process that was just given a request (there is never more than one,
+*	since it is ready again after the next pick), or -1. waits holds the waiting processes, on the list of what they
+*	wait for.
+*
+*	words holds the names of the resources, whose IDs are what the stacks and the master strings hold. strings is the
+*	arena the master strings are made in, which takes each one back once it is printed. out and err are where the
+*	output and the errors of the simulation go.
+*/
+struct simulation {
+	int n;
+	int m;
+	int time;
+	struct bankers bankers;
+	struct process* processes;
+	int* remaining;
+	struct resource_stack* resources;
+	struct word_table* words;
+	struct arena strings;
+	struct scheduling scheduling;
+	struct wait_lists waits;
+	int requested;
+	FILE* out;
+	FILE* err;
+};
+
+/*
+*	One scheduler of run_event_engines, with the state it starts from, and the output and errors it wrote to its own
+*	buffers
+*/
+struct engine_run {
+	int scheduler;
+	int n;
+	int m;
+	struct bankers* bankers;
+	struct process* processes;
+	struct resource_stack* resources;
+	struct word_table* words;
+	char* out;
+	size_t out_size;
+	char* err;
+	size_t err_size;
+	int result;
+};
+
+/*
+*	Print the state of the system for process idx, the way the commanding process does after a request and for
+*	print_resources_used
+*/
+static void print_state(struct simulation* sim, int idx) {
+	int m = sim->m;
+	fprintf(sim->out, "State of the system:\n");
+	fprintf(sim->out, "available = ");
+	for (int i = 0; i < m; i++) {
+		fprintf(sim->out, "%d ", sim->bankers.available[i]);
+	}
+	fprintf(sim->out, "\n");
+	fprintf(sim->out, "max[%d] = ", idx+1);
+	for (int j = 0; j < m; j++) {
+		fprintf(sim->out, "%d ", sim->bankers.max[idx * m + j]);
+	}
+	fprintf(sim->out, "\n");
+	fprintf(sim->out, "allocation[%d] = ", idx+1);
+	for (int j = 0; j < m; j++) {
+		fprintf(sim->out, "%d ", sim->bankers.allocation[idx * m + j]);
+	}
+	fprintf(sim->out, "\n");
+	fprintf(sim->out, "need[%d] = ", idx+1);
+	for (int j = 0; j < m; j++) {
+		fprintf(sim->out, "%d ", sim->bankers.need[idx * m + j]);
+	}
+	fprintf(sim->out, "\n");
+	fprintf(sim->out, "deadline_misses[%d] = %d\n\n", idx+1, sim->processes[idx].deadline_misses);
+}
+
+/*
+*	Print the master string of process idx, the way its child does after a request and after print_resources_used. It
+*	returns 0 on success and -1 if the memory for the string could not be allocated.
+*/
+static int print_master(struct simulation* sim, int idx) {
+	struct arena_mark mark = mark_arena(&sim->strings);
+	char* master = print_master_string(&sim->processes[idx], sim->words, &sim->strings);
+	if (master == NULL) {
+		return -1;
+	}
+	fprintf(sim->out, "\n%d -- Master string: %s\n\n\n", idx + 1, master);
+	fprintf(sim->out, "------------------------------------------------------\n\n");
+	reset_arena(&sim->strings, mark);
+	return 0;
+}
+
+/*
+*	Give back every resource process idx holds to the stacks of names, when it ends. Like in the fork engine, only the
+*	names go back: available is left as it is.
+*/
+static void return_names(struct simulation* sim, int idx) {
+	struct process* p = &sim->processes[idx];
+	for (int i = 0; i < sim->m; i++) {
+		int id = pop_resource(p->arr_allocated_resrcs, i);
+		while (id != -1) {
+			push_resource(sim->resources, id, i);
+			id = pop_resource(p->arr_allocated_resrcs, i);
+		}
+	}
+}
+
+/*
+*	Run the next instruction of process idx at the current time: what its child does with it, and what the commanding
+*	process does with what the child would leave in the shared state. The code of the instruction goes in code. It
+*	returns 0 on success and -1 if the memory for the master string could not be allocated.
+*/
+static int run_instruction(struct simulation* sim, int idx, int* code) {
+	struct process* p = &sim->processes[idx];
+	int m = sim->m;
+	struct instruction* instr = next_instruction(&p->proc_instructions);
+	int* args = instruction_args(&p->proc_instructions, instr);
+	int n_args = instr->n_args < m ? instr->n_args : m;
+	// calculate(x); and use_resources(x,y); take x computation time
+	int instr_time = instr->n_args > 0 ? args[0] : 0;
+	int time = sim->time;
+	int advance = TRUE;
+
+	int icode = instr->code;
+	*code = icode;
+
+	// check if any deadline misses occurred
+	if (time > p->deadline) {
+		p->deadline_misses++;
+	}
+
+	if (icode == 1) {
+		// 1 is calculate
+		time += instr_time;
+		sim->remaining[idx] -= instr_time;
+	} else if (icode == 2) {
+		// 2 is request, which takes 1 computation time
+		time += 1;
+		sim->remaining[idx] -= 1;
+		memset(p->request_array, 0, sizeof(int) * m);
+		memcpy(p->request_array, args, sizeof(int) * n_args);
+	} else if (icode == 3) {
+		// 3 is use_resources: the first y names of every resource type held go in the master string
+		int y = instr->n_args > 1 ? args[1] : 0;
+		for (int i = 0; i < m; i++) {
+			struct resource_stack* held = &p->arr_allocated_resrcs[i];
+			for (int j = 0; j < y && j < held->size; j++) {
+				if (append_master_string(p, sim->words, held->ids[held->size - 1 - j]) == -1) {
+					return -1;
+				}
+			}
+		}
+		time += instr_time;
+		sim->remaining[idx] -= instr_time;
+	} else if (icode == 4 || icode == 5) {
+		// 4 is release and 5 is print_resources_used, which take 1 computation time
+		time += 1;
+		sim->remaining[idx] -= 1;
+	} else if (icode != 6) {
+		// anything else ends the process, as an error
+		fprintf(sim->err, "Wrong n returned\n");
+	}
+
+	// the commanding process reads the time and the remaining computation time every time the child hands the turn back
+	sim->time = time;
+	p->remaining_computation_time = sim->remaining[idx];
+
+	if (icode == 2) {
+		// if there is not enough available or the request puts the system into an unsafe state,
+		// then wait for the resources to become available
+		if (!request_is_safe(&sim->bankers, idx, p->request_array)) {
+			p->state = WAITING;
+			schedule_block(&sim->scheduling, idx);
+			wait_on(&sim->waits, idx, request_shortage(&sim->bankers, p->request_array));
+
+			// the child runs the request again later, and gets its computation time back
+			advance = FALSE;
+			sim->remaining[idx]++;
+		} else {
+			// the names of the resources go from the stacks to the process
+			for (int i = 0; i < m; i++) {
+				allocate(&sim->bankers, idx, i, p->request_array[i]);
+				for (int j = 0; j < p->request_array[i]; j++) {
+					int id = pop_resource(sim->resources, i);
+					if (id != -1) {
+						push_resource(p->arr_allocated_resrcs, id, i);
+					}
+				}
+			}
+			p->state = REQUESTED;
+			schedule_block(&sim->scheduling, idx);
+			sim->requested = idx;
+		}
+		print_state(sim, idx);
+		if (print_master(sim, idx) == -1) {
+			return -1;
+		}
+	} else if (icode == 4) {
+		for (int i = 0; i < n_args; i++) {
+			allocate(&sim->bankers, idx, i, -args[i]);
+			for (int j = 0; j < args[i]; j++) {
+				int id = pop_resource(p->arr_allocated_resrcs, i);
+				if (id != -1) {
+					push_resource(sim->resources, id, i);
+				}
+			}
+			if (args[i] > 0) {
+				wake_resource(&sim->waits, i);
+			}
+		}
+	} else if (icode == 5) {
+		print_state(sim, idx);
+		fprintf(sim->out, "deadline misses = %d\n", p->deadline_misses);
+		if (print_master(sim, idx) == -1) {
+			return -1;
+		}
+	} else if (icode != 1 && icode != 3) {
+		return_names(sim, idx);
+		sim->bankers.finish[idx] = TRUE;
+		schedule_complete(&sim->scheduling, idx);
+		wake_unsafe(&sim->waits);
+	}
+
+	if (advance) {
+		advance_instruction(&p->proc_instructions);
+	}
+	return 0;
+}
+
+/*
+*	Free everything init_simulation allocated for sim, which is also what is left of it if init_simulation failed
+*/
+static void free_simulation(struct simulation* sim) {
+	if (sim->processes != NULL) {
+		for (int i = 0; i < sim->n; i++) {
+			struct process* p = &sim->processes[i];
+			if (p->arr_allocated_resrcs != NULL) {
+				for (int j = 0; j < sim->m; j++) {
+					free_resource_stack(&p->arr_allocated_resrcs[j]);
+				}
+			}
+			free(p->arr_allocated_resrcs);
+			free(p->request_array);
+			free_master_string(&p->master);
+		}
+	}
+	if (sim->resources != NULL) {
+		for (int j = 0; j < sim->m; j++) {
+			free_resource_stack(&sim->resources[j]);
+		}
+	}
+	free(sim->resources);
+	free(sim->remaining);
+	free(sim->processes);
+	destroy_scheduling(&sim->scheduling);
+	destroy_wait_lists(&sim->waits);
+	destroy_bankers(&sim->bankers);
+	destroy_arena(&sim->strings);
+}
+
+/*
+*	Give sim copies of bankers, processes and resources of its own, and set up its scheduler and wait lists. sim->n and
+*	sim->m must be set. It returns 0 on success and -1 if the memory could not be allocated, and free_simulation frees
+*	what it allocated either way.
+*/
+static int init_simulation(struct simulation* sim, int scheduler, struct bankers* bankers, struct process* processes,
+	struct resource_stack* resources) {
+	int n = sim->n;
+	int m = sim->m;
+	// everything starts out empty, so that free_simulation can tell what was allocated
+	sim->processes = NULL;
+	sim->remaining = NULL;
+	sim->resources = NULL;
+	memset(&sim->bankers, 0, sizeof(sim->bankers));
+	memset(&sim->scheduling, 0, sizeof(sim->scheduling));
+	memset(&sim->waits, 0, sizeof(sim->waits));
+	memset(&sim->strings, 0, sizeof(sim->strings));
+	if (copy_bankers(&sim->bankers, bankers) == -1 || init_arena(&sim->strings, 4096) == -1) {
+		return -1;
+	}
+	sim->processes = (struct process*)calloc(n, sizeof(struct process));
+	sim->remaining = (int*)malloc(sizeof(int) * n);
+	sim->resources = (struct resource_stack*)calloc(m, sizeof(struct resource_stack));
+	if (sim->processes == NULL || sim->remaining == NULL || sim->resources == NULL) {
+		return -1;
+	}
+	for (int j = 0; j < m; j++) {
+		if (copy_resource_stack(&sim->resources[j], &resources[j]) == -1) {
+			return -1;
+		}
+	}
+	for (int i = 0; i < n; i++) {
+		struct process* p = &sim->processes[i];
+		// the instructions are shared with processes, and only the place in them is the copy's own
+		*p = processes[i];
+		p->proc_instructions.next = 0;
+		init_master_string(&p->master);
+		p->arr_allocated_resrcs = (struct resource_stack*)calloc(m, sizeof(struct resource_stack));
+		p->request_array = (int*)calloc(m, sizeof(int));
+		sim->remaining[i] = processes[i].remaining_computation_time;
+		if (p->arr_allocated_resrcs == NULL || p->request_array == NULL) {
+			return -1;
+		}
+	}
+	if (init_scheduling(&sim->scheduling, scheduler, n, sim->processes) == -1 || init_wait_lists(&sim->waits, n, m) == -1) {
+		return -1;
+	}
+	return 0;
+}
+
+/*
+*	This function runs the simulation of the Banker's algorithm with one scheduler (see scheduler.h) inside this
+*	process, instead of forking a process for every simulated process and passing the turn between them through
+*	semaphores. It makes the same decisions and prints the same output as the commanding process and its children of
+*	the fork engine in deadlock_avoidance.c.
+*
+*	bankers, processes (with their instructions) and resources (the stacks of IDs of names for each resource type) are
+*	the state after the input was read. They are copied, and are the same when the function returns, so that the next
+*	scheduler can run from the same state. words holds the names, and is only read.
+*
+*	The output is written to out, and the errors and counters to err. It returns 0 once every process has ended, and
+*	-1 if the simulation cannot go on (the fork engine would wait forever there) or the memory for it could not be
+*	allocated. It never exits, so that the other schedulers of run_event_engines can still finish.
+*/
+int run_event_engine(int scheduler, int n, int m, struct bankers* bankers, struct process* processes,
+	struct resource_stack* resources, struct word_table* words, FILE* out, FILE* err) {
+	struct simulation sim;
+	sim.out = out;
+	sim.err = err;
+	sim.n = n;
+	sim.m = m;
+	sim.time = 0;
+	sim.requested = -1;
+	sim.words = words;
+	const char* name = scheduler_name(scheduler);
+	if (init_simulation(&sim, scheduler, bankers, processes, resources) == -1) {
+		fprintf(sim.err, "%s: could not allocate the state of the simulation\n", name);
+		free_simulation(&sim);
+		return -1;
+	}
+	struct scheduling* scheduling = &sim.scheduling;
+
+	fprintf(sim.out, "=======================================\nBANKER'S ALGORITHM WITH %s SCHEDULING\n=======================================\n", name);
+
+	int result = 0;
+	while (scheduling->n_left > 0) {
+		// first check if any waiting process that was woken can proceed if its request can be satisfied
+		int n_woken = take_woken(&sim.waits);
+		for (int k = 0; k < n_woken; k++) {
+			int i = sim.waits.woken[k];
+			// the request is given for the check and taken back, since the process makes it again once it runs
+			if (request_is_safe(&sim.bankers, i, sim.processes[i].request_array)) {
+				sim.processes[i].state = READY;
+				schedule_arrival(scheduling, i);
+			} else {
+				wait_on(&sim.waits, i, request_shortage(&sim.bankers, sim.processes[i].request_array));
+			}
+		}
+
+		// the check of every process used to end on the last one that is not waiting, which EDF and LLF start from
+		int idx = n - 1;
+		while (idx >= 0 && sim.processes[idx].state == WAITING) {
+			idx--;
+		}
+
+		int checked = idx;
+		idx = schedule_next(scheduling, idx, sim.time);
+
+		// next, change the process with a state of REQUESTED to a state of READY
+		int requested = sim.requested;
+		if (requested != -1) {
+			sim.processes[requested].state = READY;
+			schedule_arrival(scheduling, requested);
+			sim.requested = -1;
+		}
+
+		if (idx == -1) {
+			// the scheduler has no process to pick; unless one was just given a request, none of them can go on
+			if (requested == -1) {
+				fprintf(sim.err, "%s: every process left is waiting at time %d, so the simulation cannot go on\n", name, sim.time);
+				result = -1;
+				break;
+			}
+			continue;
+		}
+
+		struct process* p = &sim.processes[idx];
+		if (sim.bankers.finish[idx] || p->state == WAITING || next_instruction(&p->proc_instructions) == NULL) {
+			// the fork engine would signal a child that has ended or cannot go on, and wait for it forever
+			fprintf(sim.err, "%s: process %d was picked at time %d but it %s, so the simulation cannot go on\n", name,
+				idx + 1, sim.time, sim.bankers.finish[idx] ? "has ended" : p->state == WAITING ? "is waiting" : "has no instructions left");
+			result = -1;
+			break;
+		}
+		p->state = RUNNING;
+		schedule_dispatch(scheduling, idx);
+
+		// like a child of the fork engine, the process goes on until it has run an instruction that is not calculate or
+		// use_resources, or the scheduler would pick another process
+		int limit = schedule_time_limit(scheduling, checked, idx);
+		int icode;
+		int failed = FALSE;
+		do {
+			if (run_instruction(&sim, idx, &icode) == -1) {
+				failed = TRUE;
+				break;
+			}
+			schedule_tick(scheduling, idx, sim.time);
+		} while ((icode == 1 || icode == 3) && sim.time < limit && next_instruction(&p->proc_instructions) != NULL);
+		if (failed) {
+			fprintf(sim.err, "%s: process %d ran out of memory at time %d, so the simulation cannot go on\n", name, idx + 1,
+				sim.time);
+			result = -1;
+			break;
+		}
+	}
+
+	// report how often the last safe sequence was still safe, and how often the scheduler switched processes
+	print_safety_counters(sim.err, (char*)name, &sim.bankers);
+	fprintf(sim.err, "%s: %d context switches\n", name, scheduling->context_switches);
+
+	free_simulation(&sim);
+	return result;
+}
+
+/*
+*	Run the simulation of one scheduler with its output and errors going to buffers of its own
+*/
+static void* run_in_buffers(void* arg) {
+	struct engine_run* run = (struct engine_run*)arg;
+	// a buffer stays NULL and empty if its stream cannot be opened
+	run->out = NULL;
+	run->out_size = 0;
+	run->err = NULL;
+	run->err_size = 0;
+	FILE* out = open_memstream(&run->out, &run->out_size);
+	FILE* err = open_memstream(&run->err, &run->err_size);
+	if (out == NULL || err == NULL) {
+		fprintf(stderr, "could not open the output buffers of %s\n", scheduler_name(run->scheduler));
+		run->result = -1;
+	} else {
+		run->result = run_event_engine(run->scheduler, run->n, run->m, run->bankers, run->processes, run->resources,
+			run->words, out, err);
+	}
+	if (out != NULL) {
+		fclose(out);
+	}
+	if (err != NULL) {
+		fclose(err);
+	}
+	return NULL;
+}
+
+/*
+*	This function runs run_event_engine for each of the n_schedulers schedulers at the same time, each on a thread of
+*	its own with its own copy of the state and its own output buffers. Once they are all done, the output of each one
+*	is printed to stdout, and its errors to stderr, in the order of schedulers, up to the first one that could not go
+*	on, so the output is the same as running them one after the other. It returns 0 if every scheduler finished and -1
+*	otherwise.
+*/
+int run_event_engines(int* schedulers, int n_schedulers, int n, int m, struct bankers* bankers,
+	struct process* processes, struct resource_stack* resources, struct word_table* words) {
+	struct engine_run* runs = (struct engine_run*)malloc(sizeof(struct engine_run) * n_schedulers);
+	pthread_t* threads = (pthread_t*)malloc(sizeof(pthread_t) * n_schedulers);
+	int* started = (int*)malloc(sizeof(int) * n_schedulers);
+	if (runs == NULL || threads == NULL || started == NULL) {
+		fprintf(stderr, "could not allocate the runs of %d schedulers\n", n_schedulers);
+		free(started);
+		free(threads);
+		free(runs);
+		return -1;
+	}
+	for (int k = 0; k < n_schedulers; k++) {
+		runs[k].scheduler = schedulers[k];
+		runs[k].n = n;
+		runs[k].m = m;
+		runs[k].bankers = bankers;
+		runs[k].processes = processes;
+		runs[k].resources = resources;
+		runs[k].words = words;
+		started[k] = pthread_create(&threads[k], NULL, run_in_buffers, &runs[k]) == 0;
+		if (!started[k]) {
+			// the scheduler can still run without a thread of its own
+			run_in_buffers(&runs[k]);
+		}
+	}
+
+	int result = 0;
+	for (int k = 0; k < n_schedulers; k++) {
+		if (started[k]) {
+			pthread_join(threads[k], NULL);
+		}
+		if (result == 0) {
+			if (runs[k].out != NULL) {
+				fwrite(runs[k].out, 1, runs[k].out_size, stdout);
+				fflush(stdout);
+			}
+			if (runs[k].err != NULL) {
+				fwrite(runs[k].err, 1, runs[k].err_size, stderr);
+			}
+			result = runs[k].result;
+		}
+		free(runs[k].out);
+		free(runs[k].err);
+	}
+	free(started);
+	free(threads);
+	free(runs);
+	return result;
+}
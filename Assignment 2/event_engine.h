@@ -0,0 +1,26 @@
+/*
+*	This function runs the simulation of the Banker's algorithm with one scheduler (see scheduler.h) inside this
+*	process, instead of forking a process for every simulated process and passing the turn between them through
+*	semaphores. It makes the same decisions and prints the same output as the commanding process and its children of
+*	the fork engine in deadlock_avoidance.c.
+*
+*	bankers, processes (with their instructions) and resources (the stacks of IDs of names for each resource type) are
+*	the state after the input was read. They are copied, and are the same when the function returns, so that the next
+*	scheduler can run from the same state. words holds the names, and is only read.
+*
+*	The output is written to out, and the errors and counters to err. It returns 0 once every process has ended, and
+*	-1 if the simulation cannot go on (the fork engine would wait forever there) or the memory for it could not be
+*	allocated. It never exits, so that the other schedulers of run_event_engines can still finish.
+*/
+int run_event_engine(int scheduler, int n, int m, struct bankers* bankers, struct process* processes,
+	struct resource_stack* resources, struct word_table* words, FILE* out, FILE* err);
+
+/*
+*	This function runs run_event_engine for each of the n_schedulers schedulers at the same time, each on a thread of
+*	its own with its own copy of the state and its own output buffers. Once they are all done, the output of each one
+*	is printed to stdout, and its errors to stderr, in the order of schedulers, up to the first one that could not go
+*	on, so the output is the same as running them one after the other. It returns 0 if every scheduler finished and -1
+*	otherwise.
+*/
+int run_event_engines(int* schedulers, int n_schedulers, int n, int m, struct bankers* bankers,
+	struct process* processes, struct resource_stack* resources, struct word_table* words);
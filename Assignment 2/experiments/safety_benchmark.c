@@ -0,0 +1,159 @@
+/*
+*	This program measures how long the two safety algorithms of bankers.c take to check one large state, and checks
+*	that they agree. Three states are tried for n processes and m resource types:
+*		loose	every process already fits in available, so one pass is enough
+*		chain	the processes can only finish from the last one to the first, each one needing what the one before it
+*			gave back, which makes the passes algorithm go over the processes n times
+*		unsafe	the chain with a first process that never fits, so both algorithms have to give up
+*	Then the chain state is checked after every one of a series of single requests and releases, the way the simulator
+*	uses it, once starting from the last safe sequence and once starting cold.
+*
+*	Compile it from this directory with
+*		gcc -O2 safety_benchmark.c ../bankers.c -o safety_benchmark
+*	(add -mavx2 to compare 8 resource types at a time instead of 4) and run it with the number of processes,
+*	resource types and checks of each state (default 10000, 100 and 3).
+*	The Banker's state takes about 20 * n * m bytes with the sorted algorithm.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../bankers.h"
+
+enum bench_state {
+	STATE_LOOSE,
+	STATE_CHAIN,
+	STATE_UNSAFE
+};
+
+static const char* state_names[] = {"loose", "chain", "unsafe"};
+
+static double now_in_seconds() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+*	Fill max, allocation and available for one of the states, and compute the need
+*/
+static void make_state(struct bankers* b, int state) {
+	int n = b->n;
+	int m = b->m;
+	srand(3360);
+	for (int j = 0; j < m; j++) {
+		b->available[j] = rand() % 10;
+	}
+	// work is what is available once the processes after i in the chain have finished
+	int* work = (int*)malloc(sizeof(int) * m);
+	for (int j = 0; j < m; j++) {
+		work[j] = b->available[j];
+	}
+	for (int i = n - 1; i >= 0; i--) {
+		int* max = b->max + (size_t)i * m;
+		int* allocation = b->allocation + (size_t)i * m;
+		for (int j = 0; j < m; j++) {
+			allocation[j] = 1 + rand() % 3;
+			max[j] = allocation[j] + (state == STATE_LOOSE ? rand() % (b->available[j] + 1) : rand() % (work[j] + 1));
+		}
+		if (state != STATE_LOOSE) {
+			// needing all of work for one resource type means it cannot go before the process after it
+			int tight = rand() % m;
+			max[tight] = allocation[tight] + work[tight];
+			if (state == STATE_UNSAFE && i == 0) {
+				max[tight]++;
+			}
+		}
+		for (int j = 0; j < m; j++) {
+			work[j] += allocation[j];
+		}
+	}
+	free(work);
+	for (int i = 0; i < n; i++) {
+		b->finish[i] = 0;
+	}
+	compute_need(b);
+}
+
+/*
+*	Run safe_state checks times with the algorithm, starting cold, and print how long one check took
+*/
+static int time_algorithm(struct bankers* b, int algorithm, const char* name, int state, int checks) {
+	if (set_safety_algorithm(b, algorithm) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	int safe = 0;
+	double start = now_in_seconds();
+	for (int c = 0; c < checks; c++) {
+		// forget the last safe sequence, so that every check is a full search
+		b->n_sequence = 0;
+		safe = safe_state(b);
+	}
+	double seconds = (now_in_seconds() - start) / checks;
+	printf("%-7s %-7s %10.3f ms/check %10.1f ns/process  %s\n", state_names[state], name, seconds * 1e3,
+		seconds * 1e9 / b->n, safe ? "safe" : "unsafe");
+	return safe;
+}
+
+/*
+*	Give a random process one more instance of a random resource type and check the state, then take it back and
+*	check again, steps times. With cold set, the last safe sequence is forgotten before every check.
+*/
+static void time_steps(struct bankers* b, int algorithm, const char* name, int steps, int cold) {
+	if (set_safety_algorithm(b, algorithm) == -1) {
+		exit(EXIT_FAILURE);
+	}
+	srand(3361);
+	b->warm_hits = 0;
+	b->warm_misses = 0;
+	double start = now_in_seconds();
+	for (int s = 0; s < steps; s++) {
+		int i = rand() % b->n;
+		int j = rand() % b->m;
+		int amount = b->available[j] > 0 && b->need[(size_t)i * b->m + j] > 0 ? 1 : 0;
+		for (int sign = 1; sign >= -1; sign -= 2) {
+			allocate(b, i, j, sign * amount);
+			if (cold) {
+				b->n_sequence = 0;
+			}
+			safe_state(b);
+		}
+	}
+	double seconds = (now_in_seconds() - start) / (2.0 * steps);
+	char label[32];
+	snprintf(label, sizeof(label), "%s %s", cold ? "cold" : "warm", name);
+	printf("steps   %-14s %10.3f ms/check  ", label, seconds * 1e3);
+	print_safety_counters(stdout, "hits", b);
+}
+
+int main(int argc, char** argv) {
+	int n = argc > 1 ? atoi(argv[1]) : 10000;
+	int m = argc > 2 ? atoi(argv[2]) : 100;
+	int checks = argc > 3 ? atoi(argv[3]) : 3;
+	struct bankers bankers;
+	if (n < 1 || m < 1 || checks < 1 || init_bankers(&bankers, n, m) == -1) {
+		fprintf(stderr, "usage: %s [processes] [resource types] [checks]\n", argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	printf("n = %d, m = %d\n", n, m);
+	int mismatches = 0;
+	for (int state = STATE_LOOSE; state <= STATE_UNSAFE; state++) {
+		make_state(&bankers, state);
+		int passes = time_algorithm(&bankers, SAFETY_PASSES, "passes", state, checks);
+		int sorted = time_algorithm(&bankers, SAFETY_SORTED, "sorted", state, checks);
+		if (passes != sorted || passes != (state != STATE_UNSAFE)) {
+			fprintf(stderr, "the algorithms disagree on the %s state\n", state_names[state]);
+			mismatches++;
+		}
+	}
+
+	make_state(&bankers, STATE_CHAIN);
+	int steps = 20 * checks;
+	time_steps(&bankers, SAFETY_PASSES, "passes", steps, 1);
+	time_steps(&bankers, SAFETY_PASSES, "passes", steps, 0);
+	time_steps(&bankers, SAFETY_SORTED, "sorted", steps, 1);
+	time_steps(&bankers, SAFETY_SORTED, "sorted", steps, 0);
+	destroy_bankers(&bankers);
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ready_queue.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	This function returns TRUE if process i comes before process j in the heap
+*/
+static int comes_before(struct ready_queue* queue, int i, int j) {
+	if (queue->primary[i] != queue->primary[j]) {
+		return queue->primary[i] < queue->primary[j];
+	}
+	if (queue->secondary[i] != queue->secondary[j]) {
+		return queue->secondary[i] < queue->secondary[j];
+	}
+	return i < j;
+}
+
+/*
+*	This function puts process i at place k of the heap
+*/
+static void place(struct ready_queue* queue, int k, int i) {
+	queue->heap[k] = i;
+	queue->position[i] = k;
+}
+
+/*
+*	This function moves the process at place k up the heap until its parent comes before it
+*/
+static void sift_up(struct ready_queue* queue, int k) {
+	int i = queue->heap[k];
+	while (k > 0) {
+		int parent = (k - 1) / 2;
+		if (!comes_before(queue, i, queue->heap[parent])) {
+			break;
+		}
+		place(queue, k, queue->heap[parent]);
+		k = parent;
+	}
+	place(queue, k, i);
+}
+
+/*
+*	This function moves the process at place k down the heap until it comes before its children
+*/
+static void sift_down(struct ready_queue* queue, int k) {
+	int i = queue->heap[k];
+	while (2 * k + 1 < queue->size) {
+		int child = 2 * k + 1;
+		if (child + 1 < queue->size && comes_before(queue, queue->heap[child + 1], queue->heap[child])) {
+			child++;
+		}
+		if (!comes_before(queue, queue->heap[child], i)) {
+			break;
+		}
+		place(queue, k, queue->heap[child]);
+		k = child;
+	}
+	place(queue, k, i);
+}
+
+/*
+*	This function allocates an empty queue for n processes, with every key at 0. It returns 0 on success and -1 if
+*	the memory could not be allocated.
+*/
+int init_ready_queue(struct ready_queue* queue, int n) {
+	// heap, position, primary and secondary, one after the other
+	int* block = (int*)calloc((size_t)4 * n, sizeof(int));
+	if (block == NULL) {
+		fprintf(stderr, "could not allocate the ready queue for %d processes\n", n);
+		return -1;
+	}
+	queue->n = n;
+	queue->size = 0;
+	queue->heap = block;
+	queue->position = queue->heap + n;
+	queue->primary = queue->position + n;
+	queue->secondary = queue->primary + n;
+	for (int i = 0; i < n; i++) {
+		queue->position[i] = -1;
+	}
+	return 0;
+}
+
+/*
+*	This function gives process i a new key, and moves it to its new place if it is in the queue
+*/
+void set_ready_key(struct ready_queue* queue, int i, int primary, int secondary) {
+	queue->primary[i] = primary;
+	queue->secondary[i] = secondary;
+	int k = queue->position[i];
+	if (k != -1) {
+		sift_up(queue, k);
+		sift_down(queue, queue->position[i]);
+	}
+}
+
+/*
+*	This function puts process i in the queue with the key it was last given, if it is not there yet
+*/
+void push_ready(struct ready_queue* queue, int i) {
+	if (queue->position[i] != -1) {
+		return;
+	}
+	place(queue, queue->size, i);
+	queue->size++;
+	sift_up(queue, queue->size - 1);
+}
+
+/*
+*	This function takes process i out of the queue, if it is there
+*/
+void remove_ready(struct ready_queue* queue, int i) {
+	int k = queue->position[i];
+	if (k == -1) {
+		return;
+	}
+	queue->position[i] = -1;
+	queue->size--;
+	if (k == queue->size) {
+		return;
+	}
+	// the last process of the heap takes the place of i, and goes up or down from there
+	int moved = queue->heap[queue->size];
+	place(queue, k, moved);
+	sift_up(queue, k);
+	sift_down(queue, queue->position[moved]);
+}
+
+/*
+*	This function returns the first process in the queue, or -1 if it is empty
+*/
+int first_ready(struct ready_queue* queue) {
+	return queue->size > 0 ? queue->heap[0] : -1;
+}
+
+/*
+*	This function returns the process that would be first if the first one were taken out, or -1 if there is none
+*/
+int second_ready(struct ready_queue* queue) {
+	if (queue->size < 2) {
+		return -1;
+	}
+	// it is one of the two children of the first
+	if (queue->size > 2 && comes_before(queue, queue->heap[2], queue->heap[1])) {
+		return queue->heap[2];
+	}
+	return queue->heap[1];
+}
+
+/*
+*	This function returns TRUE if the key of process i is smaller than the key (primary, secondary), without looking at
+*	which process comes first
+*/
+int ready_before_key(struct ready_queue* queue, int i, int primary, int secondary) {
+	if (queue->primary[i] != primary) {
+		return queue->primary[i] < primary;
+	}
+	return queue->secondary[i] < secondary;
+}
+
+/*
+*	This function returns TRUE if the key of process i is smaller than the key of process j, without looking at which
+*	process comes first (that is how the schedulers compare a process with the one they already have)
+*/
+int ready_before(struct ready_queue* queue, int i, int j) {
+	return ready_before_key(queue, i, queue->primary[j], queue->secondary[j]);
+}
+
+/*
+*	This function frees the memory of the queue
+*/
+void destroy_ready_queue(struct ready_queue* queue) {
+	free(queue->heap);
+	queue->heap = NULL;
+	queue->position = NULL;
+	queue->primary = NULL;
+	queue->secondary = NULL;
+	queue->size = 0;
+}
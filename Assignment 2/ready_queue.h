@@ -0,0 +1,71 @@
+/*
+*	This is a binary heap of the processes that a scheduler can pick from, with the position of every process in the
+*	heap kept next to it, so that a process can be taken out or get a new key without searching the heap.
+*
+*	Every process i has a key of two numbers, primary[i] and secondary[i], and the first process is the one with the
+*	smallest primary, then the smallest secondary, then the smallest i. The keys of the processes that are not in the
+*	heap are kept too, so that the scheduler can compare the first process with any other one.
+*/
+struct ready_queue {
+	int n;
+	int size;
+	int* heap;
+	int* position;
+	int* primary;
+	int* secondary;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function allocates an empty queue for n processes, with every key at 0. It returns 0 on success and -1 if
+*	the memory could not be allocated.
+*/
+int init_ready_queue(struct ready_queue* queue, int n);
+
+/*
+*	This function gives process i a new key, and moves it to its new place if it is in the queue
+*/
+void set_ready_key(struct ready_queue* queue, int i, int primary, int secondary);
+
+/*
+*	This function puts process i in the queue with the key it was last given, if it is not there yet
+*/
+void push_ready(struct ready_queue* queue, int i);
+
+/*
+*	This function takes process i out of the queue, if it is there
+*/
+void remove_ready(struct ready_queue* queue, int i);
+
+/*
+*	This function returns the first process in the queue, or -1 if it is empty
+*/
+int first_ready(struct ready_queue* queue);
+
+/*
+*	This function returns the process that would be first if the first one were taken out, or -1 if there is none
+*/
+int second_ready(struct ready_queue* queue);
+
+/*
+*	This function returns TRUE if the key of process i is smaller than the key (primary, secondary), without looking at
+*	which process comes first
+*/
+int ready_before_key(struct ready_queue* queue, int i, int primary, int secondary);
+
+/*
+*	This function returns TRUE if the key of process i is smaller than the key of process j, without looking at which
+*	process comes first (that is how the schedulers compare a process with the one they already have)
+*/
+int ready_before(struct ready_queue* queue, int i, int j);
+
+/*
+*	This function frees the memory of the queue
+*/
+void destroy_ready_queue(struct ready_queue* queue);
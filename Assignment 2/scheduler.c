@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <strings.h>
+
+#include "simple_process.h"
+#include "ready_queue.h"
+#include "scheduler.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	Take process i out of the ready queue, when it waits or has been given a request
+*/
+static void block_process(struct scheduling* s, int i) {
+	remove_ready(&s->ready, i);
+}
+
+/*
+*	Take process i out of the ready queue for good
+*/
+static void complete_process(struct scheduling* s, int i) {
+	remove_ready(&s->ready, i);
+	s->n_left--;
+}
+
+/*
+*	Put process i at the back of the ready queue, for FIFO and RR
+*/
+static void arrive_at_back(struct scheduling* s, int i) {
+	set_ready_key(&s->ready, i, s->arrivals++, 0);
+	push_ready(&s->ready, i);
+}
+
+static void ignore_tick(struct scheduling* s, int i) {
+	(void)s;
+	(void)i;
+}
+
+/*
+*	The policies that only pick again when a process blocks or ends
+*/
+static int no_time_limit(struct scheduling* s, int i) {
+	(void)s;
+	(void)i;
+	return INT_MAX;
+}
+
+/*
+*	The first process in the ready queue, or -1
+*/
+static int select_first(struct scheduling* s, int idx) {
+	(void)idx;
+	return first_ready(&s->ready);
+}
+
+/*
+*	EDF: the key is (deadline, -computation time). Like the first version, which scanned the processes starting from
+*	idx, the first process only takes the place of idx if its key comes strictly before it, and idx is kept until every
+*	process has ended even if nothing can be picked.
+*/
+static void arrive_edf(struct scheduling* s, int i) {
+	set_ready_key(&s->ready, i, s->processes[i].deadline, -s->processes[i].computation_time);
+	push_ready(&s->ready, i);
+}
+
+static int select_edf(struct scheduling* s, int idx) {
+	if (s->n_left == 0) {
+		return -1;
+	}
+	if (idx == -1) {
+		// every process is waiting, so none of them has finished
+		idx = 0;
+	}
+	int first = first_ready(&s->ready);
+	if (first != -1 && ready_before(&s->ready, first, idx)) {
+		idx = first;
+	}
+	return idx;
+}
+
+/*
+*	LLF: the laxity of a process is deadline - time - remaining computation time, and since the time is the same for
+*	every process, the key is (deadline - remaining computation time, computation time) and only the process that ran
+*	gets a new key. Like the first version, the lowest laxity starts at 100000 instead of the laxity of idx, so the
+*	first process takes the place of idx if its key comes strictly before (100000, computation time of idx).
+*/
+static void key_llf(struct scheduling* s, int i) {
+	struct process* p = &s->processes[i];
+	set_ready_key(&s->ready, i, p->deadline - p->remaining_computation_time, p->computation_time);
+}
+
+static void arrive_llf(struct scheduling* s, int i) {
+	key_llf(s, i);
+	push_ready(&s->ready, i);
+}
+
+/*
+*	As process i runs, its key goes up by as much as the time does, so it stays before 100000 + time if it was before it,
+*	and stays first until its key reaches the key of the process that comes after it
+*/
+static int time_limit_llf(struct scheduling* s, int i) {
+	int other = second_ready(&s->ready);
+	if (other == -1) {
+		return INT_MAX;
+	}
+	struct ready_queue* q = &s->ready;
+	long long limit = (long long)s->time + q->primary[other] - q->primary[i];
+	if (q->secondary[i] < q->secondary[other] || (q->secondary[i] == q->secondary[other] && i < other)) {
+		// process i still comes first when both keys are the same
+		limit++;
+	}
+	if (limit > INT_MAX) {
+		return INT_MAX;
+	}
+	return limit < s->time ? s->time : (int)limit;
+}
+
+static int select_llf(struct scheduling* s, int idx) {
+	int first = first_ready(&s->ready);
+	if (first == -1) {
+		return -1;
+	}
+	// a process is ready, so not every process is waiting and idx is set
+	if (ready_before_key(&s->ready, first, 100000 + s->time, s->processes[idx].computation_time)) {
+		idx = first;
+	}
+	return idx;
+}
+
+/*
+*	RM and DM key on a fixed priority of the process, and break ties by the order of the processes
+*/
+static void arrive_by_priority(struct scheduling* s, int i, int priority) {
+	set_ready_key(&s->ready, i, priority, 0);
+	push_ready(&s->ready, i);
+}
+
+/*
+*	RM: the key is the period, which the input does not give, so it is the time from the arrival of the process (at
+*	time 0) to its deadline
+*/
+static void arrive_rm(struct scheduling* s, int i) {
+	int arrival = 0;
+	arrive_by_priority(s, i, s->processes[i].deadline - arrival);
+}
+
+/*
+*	DM: the key is the relative deadline, which is the deadline since the process arrives at time 0
+*/
+static void arrive_dm(struct scheduling* s, int i) {
+	arrive_by_priority(s, i, s->processes[i].deadline);
+}
+
+/*
+*	SJF: the key is the computation time
+*/
+static void arrive_sjf(struct scheduling* s, int i) {
+	set_ready_key(&s->ready, i, s->processes[i].computation_time, 0);
+	push_ready(&s->ready, i);
+}
+
+/*
+*	RR: once the process that runs has had its quantum, it goes to the back of the ready queue
+*/
+static void tick_rr(struct scheduling* s, int i) {
+	if (s->time - s->slice_start >= ROUND_ROBIN_QUANTUM) {
+		set_ready_key(&s->ready, i, s->arrivals++, 0);
+		s->slice_start = s->time;
+	}
+}
+
+static int time_limit_rr(struct scheduling* s, int i) {
+	(void)i;
+	return s->slice_start + ROUND_ROBIN_QUANTUM;
+}
+
+/*
+*	The policies, in the order of enum scheduler
+*/
+static const struct policy policies[N_SCHEDULERS] = {
+	{"EDF", select_edf, arrive_edf, block_process, complete_process, ignore_tick, no_time_limit},
+	{"LLF", select_llf, arrive_llf, block_process, complete_process, key_llf, time_limit_llf},
+	{"RM", select_first, arrive_rm, block_process, complete_process, ignore_tick, no_time_limit},
+	{"DM", select_first, arrive_dm, block_process, complete_process, ignore_tick, no_time_limit},
+	{"FIFO", select_first, arrive_at_back, block_process, complete_process, ignore_tick, no_time_limit},
+	{"SJF", select_first, arrive_sjf, block_process, complete_process, ignore_tick, no_time_limit},
+	{"RR", select_first, arrive_at_back, block_process, complete_process, tick_rr, time_limit_rr}
+};
+
+/*
+*	This function returns the scheduler with the name (edf, llf, rm, dm, fifo, sjf or rr), or -1 if there is none
+*/
+int find_scheduler(const char* name) {
+	for (int i = 0; i < N_SCHEDULERS; i++) {
+		if (strcasecmp(name, policies[i].name) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+*	This function returns the name of the scheduler, in upper case, the way it is printed
+*/
+const char* scheduler_name(int scheduler) {
+	return policies[scheduler].name;
+}
+
+/*
+*	This function sets up the scheduler for the n processes, and lets every one of them arrive. processes is read for
+*	the deadlines and computation times, and the remaining computation time for LLF, so the engine has to keep it up to
+*	date. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_scheduling(struct scheduling* s, int scheduler, int n, struct process* processes) {
+	if (init_ready_queue(&s->ready, n) == -1) {
+		return -1;
+	}
+	s->policy = &policies[scheduler];
+	s->n = n;
+	s->time = 0;
+	s->processes = processes;
+	s->n_left = n;
+	s->arrivals = 0;
+	s->slice_start = 0;
+	s->last = -1;
+	s->context_switches = 0;
+	for (int i = 0; i < n; i++) {
+		s->policy->on_arrival(s, i);
+	}
+	return 0;
+}
+
+/*
+*	These functions call the functions of the policy (see struct policy), with time as the current time
+*/
+int schedule_next(struct scheduling* s, int idx, int time) {
+	s->time = time;
+	return s->policy->select_next(s, idx);
+}
+
+void schedule_arrival(struct scheduling* s, int i) {
+	s->policy->on_arrival(s, i);
+}
+
+void schedule_block(struct scheduling* s, int i) {
+	s->policy->on_block(s, i);
+}
+
+void schedule_complete(struct scheduling* s, int i) {
+	s->policy->on_complete(s, i);
+}
+
+void schedule_tick(struct scheduling* s, int i, int time) {
+	s->time = time;
+	s->policy->on_tick(s, i);
+}
+
+/*
+*	This function records that process i was picked and is about to run
+*/
+void schedule_dispatch(struct scheduling* s, int i) {
+	if (s->last != i) {
+		if (s->last != -1) {
+			s->context_switches++;
+		}
+		s->slice_start = s->time;
+	}
+	s->last = i;
+}
+
+/*
+*	This function returns the time until which process i, which was just picked and dispatched from idx, stays the pick
+*	while only process i runs: process i can go on with its next instruction as long as the time is before it, without
+*	asking the scheduler again. It is the current time if process i has to be picked again after every instruction.
+*/
+int schedule_time_limit(struct scheduling* s, int idx, int i) {
+	if (first_ready(&s->ready) != i || s->policy->select_next(s, idx) != i) {
+		// process i was picked in place of the first one, or the first one has changed since
+		return s->time;
+	}
+	return s->policy->time_limit(s, i);
+}
+
+/*
+*	This function frees the memory of the scheduler
+*/
+void destroy_scheduling(struct scheduling* s) {
+	destroy_ready_queue(&s->ready);
+}
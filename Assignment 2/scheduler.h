@@ -0,0 +1,119 @@
+/*
+*	The schedulers a simulation can use.
+*		EDF	Earliest-Deadline-First, with Longest-Job-First as tie breaker
+*		LLF	Least-Laxity-First, with Shortest-Job-First as tie breaker
+*		RM	Rate-Monotonic: the shortest period first
+*		DM	Deadline-Monotonic: the shortest relative deadline first
+*		FIFO	the process that became ready first, until it waits, makes a request or ends
+*		SJF	Shortest-Job-First by computation time
+*		RR	Round-Robin: like FIFO, but a process goes to the back once it has run for ROUND_ROBIN_QUANTUM time
+*	RM, DM and SJF break ties by the order of the processes in the input.
+*
+*	The input gives a process no period, so RM takes the time from its arrival to its deadline as its period. Every
+*	process arrives at time 0, so that is also its relative deadline, and RM picks the same processes as DM for now.
+*/
+enum scheduler {
+	SCHEDULER_EDF,
+	SCHEDULER_LLF,
+	SCHEDULER_RM,
+	SCHEDULER_DM,
+	SCHEDULER_FIFO,
+	SCHEDULER_SJF,
+	SCHEDULER_RR,
+	N_SCHEDULERS
+};
+
+#define ROUND_ROBIN_QUANTUM 4
+
+struct scheduling;
+
+/*
+*	A scheduling policy is the set of functions an engine calls as the simulation goes on:
+*		select_next	returns the process to run next, or -1 if there is none. idx is the process the check of the
+*				waiting processes ended on, which EDF and LLF start from like the first version did
+*		on_arrival	process i can be picked again: at the start, after waiting, and after being given a request
+*		on_block	process i cannot be picked: it waits for a request, or has just been given one
+*		on_complete	process i has ended
+*		on_tick		process i has run an instruction, and time is the time after it
+*		time_limit	process i was picked and is the first of the ready queue: the time until which it stays the
+*				pick if no other process changes, or INT_MAX if it stays the pick until it blocks or ends
+*/
+struct policy {
+	const char* name;
+	int (*select_next)(struct scheduling* s, int idx);
+	void (*on_arrival)(struct scheduling* s, int i);
+	void (*on_block)(struct scheduling* s, int i);
+	void (*on_complete)(struct scheduling* s, int i);
+	void (*on_tick)(struct scheduling* s, int i);
+	int (*time_limit)(struct scheduling* s, int i);
+};
+
+/*
+*	This holds the state of one scheduler for n processes. ready holds the processes that can be picked, keyed the way
+*	the policy wants them, time is the current time of the simulation, and n_left the number of processes that have not
+*	ended. arrivals counts the arrivals, so that FIFO and RR can key on the order of arrival, and slice_start is when the
+*	process that runs now was picked. last is the process that ran last, and context_switches counts the picks of a
+*	different process than that one.
+*/
+struct scheduling {
+	const struct policy* policy;
+	int n;
+	int time;
+	struct process* processes;
+	struct ready_queue ready;
+	int n_left;
+	int arrivals;
+	int slice_start;
+	int last;
+	int context_switches;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function returns the scheduler with the name (edf, llf, rm, dm, fifo, sjf or rr), or -1 if there is none
+*/
+int find_scheduler(const char* name);
+
+/*
+*	This function returns the name of the scheduler, in upper case, the way it is printed
+*/
+const char* scheduler_name(int scheduler);
+
+/*
+*	This function sets up the scheduler for the n processes, and lets every one of them arrive. processes is read for
+*	the deadlines and computation times, and the remaining computation time for LLF, so the engine has to keep it up to
+*	date. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_scheduling(struct scheduling* s, int scheduler, int n, struct process* processes);
+
+/*
+*	These functions call the functions of the policy (see struct policy), with time as the current time
+*/
+int schedule_next(struct scheduling* s, int idx, int time);
+void schedule_arrival(struct scheduling* s, int i);
+void schedule_block(struct scheduling* s, int i);
+void schedule_complete(struct scheduling* s, int i);
+void schedule_tick(struct scheduling* s, int i, int time);
+
+/*
+*	This function records that process i was picked and is about to run
+*/
+void schedule_dispatch(struct scheduling* s, int i);
+
+/*
+*	This function returns the time until which process i, which was just picked and dispatched from idx, stays the pick
+*	while only process i runs: process i can go on with its next instruction as long as the time is before it, without
+*	asking the scheduler again. It is the current time if process i has to be picked again after every instruction.
+*/
+int schedule_time_limit(struct scheduling* s, int idx, int i);
+
+/*
+*	This function frees the memory of the scheduler
+*/
+void destroy_scheduling(struct scheduling* s);
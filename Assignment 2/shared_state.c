@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+#include "simple_process.h"
+#include "bankers.h"
+#include "shared_state.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	This function returns the number of bytes of the mapping: the struct and the one of the Banker's state, then
+*	remaining and deadline_misses (n each), amounts and n_ids (m each), first_id (m + 1), the IDs and the block of the
+*	Banker's state, one after the other
+*/
+static size_t shared_size(int n, int m, int n_ids) {
+	return sizeof(struct shared_state) + sizeof(struct bankers)
+		+ sizeof(int) * (2 * (size_t)n + 3 * (size_t)m + 1 + (size_t)n_ids + bankers_block_size(n, m));
+}
+
+/*
+*	This function maps a shared state for n processes and m resource types, with a copy of bankers, room for as many
+*	IDs of every resource type as resources holds, and the remaining computation time of every process from processes.
+*	It returns NULL if the memory could not be mapped.
+*/
+struct shared_state* map_shared_state(int n, int m, struct bankers* bankers, struct process* processes,
+	struct resource_stack* resources) {
+	int n_ids = 0;
+	for (int j = 0; j < m; j++) {
+		n_ids += resources[j].size;
+	}
+	void* memory = mmap(NULL, shared_size(n, m, n_ids), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (memory == MAP_FAILED) {
+		fprintf(stderr, "could not map the shared state: %s\n", strerror(errno));
+		return NULL;
+	}
+
+	// the mapping starts out zeroed
+	struct shared_state* shared = (struct shared_state*)memory;
+	shared->n = n;
+	shared->m = m;
+	shared->bankers = (struct bankers*)(shared + 1);
+	shared->remaining = (int*)(shared->bankers + 1);
+	shared->deadline_misses = shared->remaining + n;
+	shared->amounts = shared->deadline_misses + n;
+	shared->n_ids = shared->amounts + m;
+	shared->first_id = shared->n_ids + m;
+	shared->ids = shared->first_id + m + 1;
+	shared->first_id[0] = 0;
+	for (int j = 0; j < m; j++) {
+		shared->first_id[j + 1] = shared->first_id[j] + resources[j].size;
+	}
+	for (int i = 0; i < n; i++) {
+		shared->remaining[i] = processes[i].remaining_computation_time;
+		shared->deadline_misses[i] = processes[i].deadline_misses;
+	}
+	if (copy_bankers_into(shared->bankers, bankers, shared->ids + n_ids) == -1) {
+		munmap(memory, shared_size(n, m, n_ids));
+		return NULL;
+	}
+	return shared;
+}
+
+/*
+*	This function returns where the IDs of resource type j go
+*/
+int* shared_ids(struct shared_state* shared, int j) {
+	return shared->ids + shared->first_id[j];
+}
+
+/*
+*	This function destroys the Banker's state of the shared state and unmaps it
+*/
+void unmap_shared_state(struct shared_state* shared) {
+	destroy_bankers(shared->bankers);
+	munmap(shared, shared_size(shared->n, shared->m, shared->first_id[shared->m]));
+}
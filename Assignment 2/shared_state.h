@@ -0,0 +1,66 @@
+/*
+*	The shared state is the memory the commanding process of the fork engine shares with its children, instead of the
+*	messages it used to pass through pipes. It holds the Banker's state of the simulation, the state of every process
+*	and the clock. It is mapped before the children are forked, so that every process sees it
+*	at the same address, and the turn only goes back and forth through the semaphores: a process only reads or writes
+*	the shared state while it has the turn, and the semaphore operation that hands the turn over is what makes what it
+*	wrote seen by the next one, so there is no lock.
+*
+*	time is the simulated clock and limit the time until which the child that has the turn goes on without handing it
+*	back. code is the instruction the child stopped at, and status_code the answer of the commanding process to a
+*	request: 0 if it was given, and 1 if the process has to wait. remaining and deadline_misses hold the remaining
+*	computation time and the deadline misses of every process, which its child keeps up to date.
+*
+*	bankers is the Banker's state the commanding process runs the simulation on, with its tables in the shared memory
+*	too. Only the commanding process changes it. The memory of the sorted safety algorithm (see set_safety_algorithm)
+*	is scratch space of the commanding process, and is not shared.
+*
+*	amounts holds the amount of every resource type the child requests or releases. ids holds the IDs of the resources
+*	that go with it (the ones given for a request, and the ones given back with a release or an end), with the ones of
+*	resource type j at ids + first_id[j] and n_ids[j] of them. There is room for every resource of the type, so they
+*	always fit.
+*/
+struct process;
+struct resource_stack;
+struct bankers;
+
+struct shared_state {
+	int n;
+	int m;
+	int time;
+	int limit;
+	int code;
+	int status_code;
+	struct bankers* bankers;
+	int* remaining;
+	int* deadline_misses;
+	int* amounts;
+	int* n_ids;
+	int* first_id;
+	int* ids;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function maps a shared state for n processes and m resource types, with a copy of bankers, room for as many
+*	IDs of every resource type as resources holds, and the remaining computation time of every process from processes.
+*	It returns NULL if the memory could not be mapped.
+*/
+struct shared_state* map_shared_state(int n, int m, struct bankers* bankers, struct process* processes,
+	struct resource_stack* resources);
+
+/*
+*	This function returns where the IDs of resource type j go
+*/
+int* shared_ids(struct shared_state* shared, int j);
+
+/*
+*	This function destroys the Banker's state of the shared state and unmaps it
+*/
+void unmap_shared_state(struct shared_state* shared);
@@ -7,84 +7,309 @@
 #include <string.h>
 #include <errno.h>
 
+#include "word_table.h"
+#include "arena.h"
 #include "simple_process.h"
 
 /*
-*	This functions inserts a new instruction to the end of the queue. As input, it takes in the address to the queue, as well
-*	as the instruction to be inserted.
-*	This function receives the address to the pointer to the head of the linked list representing the queue. This is because
-*	changes made to the pointer is not saved once the function returns, and so changes made to the pointer to the queue must be done
-*	by a pointer pointing to it.
+*	This function sets up an empty list of instructions
 */
-void enqueue_instruction(struct instruction** proc_instruct, char* new_instruct) {
-	struct instruction* new_node = (struct instruction*)malloc(sizeof(struct instruction));
-	new_node->instruction = strdup(new_instruct);	// avoid complications by duping the string
-	new_node->next_instruction = NULL;
-	if (*proc_instruct == NULL) {
-		*proc_instruct = new_node;
-	} else {
-		struct instruction* last_element = *proc_instruct;
-		while (last_element->next_instruction != NULL)
-			last_element = last_element->next_instruction;
-		last_element->next_instruction = new_node;
+void init_instructions(struct instruction_list* list) {
+	list->instructions = NULL;
+	list->n_instructions = 0;
+	list->capacity = 0;
+	list->args = NULL;
+	list->n_args = 0;
+	list->args_capacity = 0;
+	list->next = 0;
+}
+
+/*
+*	This function decodes an instruction string, like request(1,2,3);, and adds it to the end of the list. It returns 0
+*	on success and -1 if the memory could not be allocated.
+*/
+int add_instruction(struct instruction_list* list, char* instr_str) {
+	if (list->n_instructions == list->capacity) {
+		int capacity = list->capacity == 0 ? 16 : 2 * list->capacity;
+		struct instruction* instructions = (struct instruction*)realloc(list->instructions, sizeof(struct instruction) * capacity);
+		if (instructions == NULL) {
+			fprintf(stderr, "could not allocate %d instructions\n", capacity);
+			return -1;
+		}
+		list->instructions = instructions;
+		list->capacity = capacity;
+	}
+	struct instruction* instr = &list->instructions[list->n_instructions];
+	instr->code = parse_instruction(instr_str);
+	instr->n_args = 0;
+	instr->first_arg = list->n_args;
+
+	// the arguments are the pieces after the name, split the same way as the name
+	char* temp = strdup(instr_str);
+	if (temp == NULL) {
+		fprintf(stderr, "could not copy the instruction %s", instr_str);
+		return -1;
 	}
+	char* rest;
+	strtok_r(temp, "(,);\n", &rest);
+	char* tok = strtok_r(NULL, "(,);\n", &rest);
+	while (tok != NULL) {
+		if (list->n_args == list->args_capacity) {
+			int capacity = list->args_capacity == 0 ? 16 : 2 * list->args_capacity;
+			int* args = (int*)realloc(list->args, sizeof(int) * capacity);
+			if (args == NULL) {
+				fprintf(stderr, "could not allocate %d instruction arguments\n", capacity);
+				free(temp);
+				return -1;
+			}
+			list->args = args;
+			list->args_capacity = capacity;
+		}
+		list->args[list->n_args] = 0;
+		sscanf(tok, "%d", &list->args[list->n_args]);
+		list->n_args++;
+		instr->n_args++;
+		tok = strtok_r(NULL, "(,);\n", &rest);
+	}
+	free(temp);
+	list->n_instructions++;
+	return 0;
 }
 
 /*
-*	This functions removes an instruction at the front of the queue, and returns it. As input, it takes in the address to a pointer
+*	This function returns the instruction that runs next, or NULL if every instruction has run
 */
-char* deque_instruction(struct instruction** proc_instruct) {
-	if (*proc_instruct == NULL) {
+struct instruction* next_instruction(struct instruction_list* list) {
+	if (list->next >= list->n_instructions) {
 		return NULL;
 	}
-	struct instruction* head = *proc_instruct;
-	char* cur_instruct = (*proc_instruct)->instruction;
-	*proc_instruct = head->next_instruction;
-	free(head);
-	return cur_instruct;
+	return &list->instructions[list->next];
+}
+
+/*
+*	This function returns the arguments of an instruction of the list
+*/
+int* instruction_args(struct instruction_list* list, struct instruction* instr) {
+	return list->args + instr->first_arg;
+}
+
+/*
+*	This function moves the list on to the instruction after the one that has just run
+*/
+void advance_instruction(struct instruction_list* list) {
+	list->next++;
 }
 
 /*
-*	This function receives a pointer to the pointer to the head of the linked list representing the stack. This is because
-*	changes made to the pointer is not saved once the function returns, and so changes made to the pointer to the stack must be done
-*	by a pointer pointing to it.
+*	This function frees the memory of the list
 */
-void push_resource_og(struct resource** resources, char* name) {
-	struct resource* new_head = (struct resource*)malloc(sizeof(struct resource));
-	new_head->resource_name = strdup(name);		// avoid complications by duping the string
-    new_head->next_resource = NULL;
-	if (*resources != NULL)
-		new_head->next_resource = *resources;
-	*resources = new_head;
+void free_instructions(struct instruction_list* list) {
+	free(list->instructions);
+	free(list->args);
+	init_instructions(list);
 }
 
 /*
 *	This function receives an array of stacks, as well as the index of the array, and pushes the resource onto the stack responsible
 */
-void push_resource(struct resource** resources, char* name, int type) {
-	push_resource_og(&resources[type], name);
+void push_resource(struct resource_stack* resources, int id, int type) {
+	struct resource_stack* stack = &resources[type];
+	if (stack->size == stack->capacity) {
+		int capacity = stack->capacity == 0 ? 8 : 2 * stack->capacity;
+		int* ids = (int*)realloc(stack->ids, sizeof(int) * capacity);
+		if (ids == NULL) {
+			fprintf(stderr, "could not make room for %d resources of type %d\n", capacity, type);
+			return;
+		}
+		stack->ids = ids;
+		stack->capacity = capacity;
+	}
+	stack->ids[stack->size++] = id;
+}
+
+/*
+*	This function receives an array of stacks, as well as the index of the array, and pops the resource off the stack responsible.
+*	It returns the word ID of the resource, or -1 if the stack is empty.
+*/
+int pop_resource(struct resource_stack* resources, int type) {
+	struct resource_stack* stack = &resources[type];
+	if (stack->size == 0) {
+		return -1;
+	}
+	return stack->ids[--stack->size];
+}
+
+/*
+*	This function reads the instruction strings and returns the type of string it is encoded as an integer
+*	It returns:
+*		- 1 if instruction is calculate
+*		- 2 if instruction is request
+*		- 3 if instruction is use_resource
+*		- 4 if instruction is release
+*		- 5 if instruction is print_resources_used
+*		- 6 if instruction is end.
+*/
+int parse_instruction(char* instr_str) {
+	// strtok_r, so that the event engine can parse instructions on several threads at once
+	char* temp = strdup(instr_str);
+	if (temp == NULL) {
+		fprintf(stderr, "could not copy the instruction %s", instr_str);
+		return -1;
+	}
+	char* rest;
+	strtok_r(temp, "(,);\n", &rest);
+
+	int code;
+	if (strcmp(temp, "calculate") == 0) {
+		code = 1;
+	} else if (strcmp(temp, "request") == 0) {
+		code = 2;
+	} else if (strcmp(temp, "use_resources") == 0) {
+		code = 3;
+	} else if (strcmp(temp, "release") == 0) {
+		code = 4;
+	} else if (strcmp(temp, "print_resources_used") == 0) {
+		code = 5;
+	} else if (strcmp(temp, "end.") == 0) {
+		code = 6;
+	} else {
+		fprintf(stderr, "temp (%s)\n", temp);
+		code = -1;
+	}
+	free(temp);
+	return code;
+}
+
+/*
+*	This function sets up an empty master string
+*/
+void init_master_string(struct master_string* master) {
+	master->ids = NULL;
+	master->counts = NULL;
+	master->n_words = 0;
+	master->capacity = 0;
+	master->length = 1;
 }
 
+/*
+*	This function adds the name of a resource to the master string of the process, in its place in alphabetical order.
+*	It returns 0 on success and -1 if the memory could not be allocated, which leaves the master string as it was.
+*/
+int append_master_string(struct process* p_process, struct word_table* table, int id) {
+	struct master_string* master = &p_process->master;
+	size_t length = strlen(table->words[id]);
+	if (length == 0) {
+		// an empty name takes no room between the spaces, so it is not printed
+		return 0;
+	}
+
+	// find the first name that does not come before this one
+	int rank = table->rank[id];
+	int low = 0;
+	int high = master->n_words;
+	while (low < high) {
+		int middle = (low + high) / 2;
+		if (table->rank[master->ids[middle]] < rank) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	if (low < master->n_words && master->ids[low] == id) {
+		master->counts[low]++;
+		master->length += length + 1;
+		return 0;
+	}
+
+	if (master->n_words == master->capacity) {
+		int capacity = master->capacity == 0 ? 8 : 2 * master->capacity;
+		int* ids = (int*)realloc(master->ids, sizeof(int) * capacity);
+		if (ids == NULL) {
+			fprintf(stderr, "could not make room for %d names in the master string\n", capacity);
+			return -1;
+		}
+		master->ids = ids;
+		int* counts = (int*)realloc(master->counts, sizeof(int) * capacity);
+		if (counts == NULL) {
+			fprintf(stderr, "could not make room for %d names in the master string\n", capacity);
+			return -1;
+		}
+		master->counts = counts;
+		master->capacity = capacity;
+	}
+	// make room for the name in its place
+	memmove(master->ids + low + 1, master->ids + low, sizeof(int) * (master->n_words - low));
+	memmove(master->counts + low + 1, master->counts + low, sizeof(int) * (master->n_words - low));
+	master->ids[low] = id;
+	master->counts[low] = 1;
+	master->n_words++;
+	master->length += length + 1;
+	return 0;
+}
 
 /*
-*	This function receives a pointer to the pointer for the same reason as the other function. It returns a string; however, the real
-*	purpose of it is to simply get rid of a resource. The name and type of a resource should already be read before popping.
+*	This function takes in the string stored in p_process made from "use_resources", and outputs the master string
+*	for this process, in the arena. It returns NULL if the memory could not be allocated.
 */
-char* pop_resource_og(struct resource** resources) {
-	if (*resources == NULL) {
+char* print_master_string(struct process* p_process, struct word_table* table, struct arena* arena) {
+	struct master_string* master = &p_process->master;
+	char* final_string = (char*)arena_alloc(arena, master->length + 1);
+	if (final_string == NULL) {
+		fprintf(stderr, "could not allocate a master string of %zu characters\n", master->length);
 		return NULL;
 	}
-	struct resource* top = *resources;
-	char* resource_string = top->resource_name;
-    *resources = top->next_resource;
-	free(top);
-    top = NULL;
-	return resource_string;
+	char* end = final_string;
+	*end++ = ' ';
+	for (int k = 0; k < master->n_words; k++) {
+		const char* word = table->words[master->ids[k]];
+		size_t length = strlen(word);
+		for (int j = 0; j < master->counts[k]; j++) {
+			memcpy(end, word, length);
+			end += length;
+			*end++ = ' ';
+		}
+	}
+	*end = '\0';
+	return final_string;
 }
 
 /*
-*	This function receives an array of stacks, as well as the index of the array, and pushes the resource onto the stack responsible
+*	This function frees the memory of the master string, and leaves it empty
+*/
+void free_master_string(struct master_string* master) {
+	free(master->ids);
+	free(master->counts);
+	init_master_string(master);
+}
+
+/*
+*	This function copies a stack of resources, keeping the order of the names. It returns 0 on success and -1 if the
+*	memory could not be allocated.
 */
-char* pop_resource(struct resource** resources, int type) {
-	return pop_resource_og(&resources[type]);
-}
\ No newline at end of file
+int copy_resource_stack(struct resource_stack* copy, struct resource_stack* stack) {
+	copy->size = 0;
+	copy->capacity = 0;
+	copy->ids = NULL;
+	if (stack->size == 0) {
+		return 0;
+	}
+	copy->ids = (int*)malloc(sizeof(int) * stack->size);
+	if (copy->ids == NULL) {
+		fprintf(stderr, "could not copy a stack of %d resources\n", stack->size);
+		return -1;
+	}
+	memcpy(copy->ids, stack->ids, sizeof(int) * stack->size);
+	copy->size = stack->size;
+	copy->capacity = stack->size;
+	return 0;
+}
+
+/*
+*	This function frees the memory of a stack of resources, and leaves it empty
+*/
+void free_resource_stack(struct resource_stack* stack) {
+	free(stack->ids);
+	stack->ids = NULL;
+	stack->size = 0;
+	stack->capacity = 0;
+}
@@ -1,12 +1,28 @@
 
 
 /*
-*	Create a queue for instructions. The elements are added from the back of the linked list, and removed
-*	from the front of the linked list. The reason for this is because 
+*	An instruction, decoded once when the input is read. code is what parse_instruction returns for it, and the numbers
+*	between its parentheses are args[first_arg] to args[first_arg + n_args - 1] of its list.
 */
 struct instruction {
-	char* instruction;
-	struct instruction* next_instruction;
+	int code;
+	int n_args;
+	int first_arg;
+};
+
+/*
+*	The instructions of a process, in the order they run, with the arguments of all of them in one array. next is the
+*	instruction that runs next, and only moves on once an instruction is done with, so a request that has to wait runs
+*	again simply by leaving next where it is.
+*/
+struct instruction_list {
+	struct instruction* instructions;
+	int n_instructions;
+	int capacity;
+	int* args;
+	int n_args;
+	int args_capacity;
+	int next;
 };
 
 /*
@@ -23,6 +39,23 @@ enum process_state {
 };
 
 
+struct word_table;
+struct arena;
+
+/*
+*	The master string of a process holds every name it has used, sorted alphabetically as the names come in: ids[k] is
+*	the word ID (see word_table.h) of the k-th name in that order, counts[k] how many times it was used, and length the
+*	length of the string printed for it. The names are kept in order by their ranks, and printing goes through them
+*	once, instead of sorting them again every time.
+*/
+struct master_string {
+	int* ids;
+	int* counts;
+	int n_words;
+	int capacity;
+	size_t length;
+};
+
 /*
 *	This data structure stores the information for the process. In this assignment, the assumption made is that the arrival time for all
 *	processes are t=0
@@ -33,13 +66,12 @@ struct process {
 	int computation_time;
 	int remaining_computation_time;
 
-	struct instruction* proc_instructions;		// this will be read like a queue
-	struct resource** arr_allocated_resrcs; 	// this will be read like an array of stacks
+	struct instruction_list proc_instructions;	// this will be read like a queue
+	struct resource_stack* arr_allocated_resrcs; 	// this will be read like an array of stacks
     int* request_array;
 	enum process_state state;
 
-	char* master_str;
-	int n_str_master;	// this gives the number of strings in master_str
+	struct master_string master;
 
 	int deadline_misses;
 };
@@ -47,13 +79,13 @@ struct process {
 
 
 /*
-*	Resources are stored as a linked list which act as a stack. The stack grows from left to right, and the
-*	top of the stack is given by the current head. Popping removes the head, replacing it with the element the head points to
-*	and pushing adds a new head, pointing to the previous head
+*	Resources are stored as an array which acts as a stack of the word IDs of their names. The top of the stack is
+*	ids[size - 1], and the array grows when a push does not fit in capacity. A stack of all zeros is empty.
 */
-struct resource {
-	char* resource_name;
-	struct resource* next_resource; 
+struct resource_stack {
+	int* ids;
+	int size;
+	int capacity;
 };
 
 
@@ -64,38 +96,88 @@ struct resource {
 
 
 /*
-*	This functions inserts a new instruction to the end of the queue. As input, it takes in the address to the queue, as well
-*	as the instruction to be inserted.
-*	This function receives the address to the pointer to the head of the linked list representing the queue. This is because
-*	changes made to the pointer is not saved once the function returns, and so changes made to the pointer to the queue must be done
-*	by a pointer pointing to it.
+*	This function sets up an empty list of instructions
 */
-void enqueue_instruction(struct instruction** proc_instruct, char* new_instruct);
+void init_instructions(struct instruction_list* list);
 
 /*
-*	This functions removes an instruction at the front of the queue, and returns it. As input, it takes in the address to a pointer
+*	This function decodes an instruction string, like request(1,2,3);, and adds it to the end of the list. It returns 0
+*	on success and -1 if the memory could not be allocated.
 */
-char* deque_instruction(struct instruction** proc_instruct);
+int add_instruction(struct instruction_list* list, char* instr_str);
 
 /*
-*	This function receives a pointer to the pointer to the head of the linked list representing the stack. This is because
-*	changes made to the pointer is not saved once the function returns, and so changes made to the pointer to the stack must be done
-*	by a pointer pointing to it.
+*	This function returns the instruction that runs next, or NULL if every instruction has run
 */
-void push_resource_og(struct resource** resources, char* name);
+struct instruction* next_instruction(struct instruction_list* list);
 
 /*
-*	This function receives an array of stacks, as well as the index of the array, and pushes the resource onto the stack responsible
+*	This function returns the arguments of an instruction of the list
 */
-void push_resource(struct resource** resources, char* name, int type);
+int* instruction_args(struct instruction_list* list, struct instruction* instr);
 
 /*
-*	This function receives a pointer to the pointer for the same reason as the other function. It returns a string; however, the real
-*	purpose of it is to simply get rid of a resource. The name and type of a resource should already be read before popping.
+*	This function moves the list on to the instruction after the one that has just run
 */
-char* pop_resource_og(struct resource** resources);
+void advance_instruction(struct instruction_list* list);
+
+/*
+*	This function frees the memory of the list
+*/
+void free_instructions(struct instruction_list* list);
 
 /*
 *	This function receives an array of stacks, as well as the index of the array, and pushes the resource onto the stack responsible
 */
-char* pop_resource(struct resource** resources, int type);
\ No newline at end of file
+void push_resource(struct resource_stack* resources, int id, int type);
+
+/*
+*	This function receives an array of stacks, as well as the index of the array, and pops the resource off the stack responsible.
+*	It returns the word ID of the resource, or -1 if the stack is empty.
+*/
+int pop_resource(struct resource_stack* resources, int type);
+
+/*
+*	This function reads the instruction strings and returns the type of string it is encoded as an integer
+*	It returns:
+*		- 1 if instruction is calculate
+*		- 2 if instruction is request
+*		- 3 if instruction is use_resource
+*		- 4 if instruction is release
+*		- 5 if instruction is print_resources_used
+*		- 6 if instruction is end.
+*/
+int parse_instruction(char* instr_str);
+
+/*
+*	This function sets up an empty master string
+*/
+void init_master_string(struct master_string* master);
+
+/*
+*	This function adds the name of a resource to the master string of the process, in its place in alphabetical order.
+*	It returns 0 on success and -1 if the memory could not be allocated, which leaves the master string as it was.
+*/
+int append_master_string(struct process* p_process, struct word_table* table, int id);
+
+/*
+*	This function takes in the string stored in p_process made from "use_resources", and outputs the master string
+*	for this process, in the arena. It returns NULL if the memory could not be allocated.
+*/
+char* print_master_string(struct process* p_process, struct word_table* table, struct arena* arena);
+
+/*
+*	This function frees the memory of the master string, and leaves it empty
+*/
+void free_master_string(struct master_string* master);
+
+/*
+*	This function copies a stack of resources, keeping the order of the names. It returns 0 on success and -1 if the
+*	memory could not be allocated.
+*/
+int copy_resource_stack(struct resource_stack* copy, struct resource_stack* stack);
+
+/*
+*	This function frees the memory of a stack of resources, and leaves it empty
+*/
+void free_resource_stack(struct resource_stack* stack);
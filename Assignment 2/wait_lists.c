@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "wait_lists.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	Comparator function for qsort in take_woken
+*/
+static int process_comp(const void* p1, const void* p2) {
+	return *(const int*)p1 - *(const int*)p2;
+}
+
+/*
+*	This function takes every process off list j and puts it in woken
+*/
+static void wake_list(struct wait_lists* waits, int j) {
+	int i = waits->head[j];
+	while (i != -1) {
+		int after = waits->next[i];
+		waits->next[i] = -1;
+		waits->list[i] = -1;
+		waits->woken[waits->n_woken++] = i;
+		i = after;
+	}
+	waits->head[j] = -1;
+}
+
+/*
+*	This function allocates empty lists for n processes and m resource types. It returns 0 on success and -1 if the
+*	memory could not be allocated.
+*/
+int init_wait_lists(struct wait_lists* waits, int n, int m) {
+	// head (m + 1 lists), next, list and woken, one after the other
+	int* block = (int*)malloc(sizeof(int) * ((size_t)m + 1 + (size_t)3 * n));
+	if (block == NULL) {
+		fprintf(stderr, "could not allocate the wait lists for %d processes\n", n);
+		return -1;
+	}
+	waits->n = n;
+	waits->m = m;
+	waits->head = block;
+	waits->next = waits->head + m + 1;
+	waits->list = waits->next + n;
+	waits->woken = waits->list + n;
+	waits->n_woken = 0;
+	for (int j = 0; j <= m; j++) {
+		waits->head[j] = -1;
+	}
+	for (int i = 0; i < n; i++) {
+		waits->next[i] = -1;
+		waits->list[i] = -1;
+	}
+	return 0;
+}
+
+/*
+*	This function puts process i on the list of resource type j, the first one there is not enough available of for
+*	its request, or on the list of unsafe requests if j is -1 (see request_shortage in bankers.h)
+*/
+void wait_on(struct wait_lists* waits, int i, int j) {
+	if (j == -1) {
+		j = waits->m;
+	}
+	waits->list[i] = j;
+	waits->next[i] = waits->head[j];
+	waits->head[j] = i;
+}
+
+/*
+*	This function wakes the processes that wait for resource type j and the ones whose requests were unsafe, once
+*	resource type j has been released
+*/
+void wake_resource(struct wait_lists* waits, int j) {
+	wake_list(waits, j);
+	wake_list(waits, waits->m);
+}
+
+/*
+*	This function wakes the processes whose requests were unsafe, once a process has ended
+*/
+void wake_unsafe(struct wait_lists* waits) {
+	wake_list(waits, waits->m);
+}
+
+/*
+*	This function returns how many processes were woken since it was last called, and puts them at the start of woken
+*	in the order of the processes. They stay there until the next process is woken.
+*/
+int take_woken(struct wait_lists* waits) {
+	int n_woken = waits->n_woken;
+	qsort(waits->woken, n_woken, sizeof(int), process_comp);
+	waits->n_woken = 0;
+	return n_woken;
+}
+
+/*
+*	This function frees the memory of the lists
+*/
+void destroy_wait_lists(struct wait_lists* waits) {
+	free(waits->head);
+	waits->head = NULL;
+	waits->next = NULL;
+	waits->list = NULL;
+	waits->woken = NULL;
+	waits->n_woken = 0;
+}
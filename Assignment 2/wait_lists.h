@@ -0,0 +1,65 @@
+/*
+*	These are the lists of the processes that wait for a request, so that the engines only check the request of a
+*	waiting process again once something it could be waiting for has changed, instead of checking every waiting
+*	process on every turn.
+*
+*	There is one list for every resource type, and one more (list m) for the requests there is enough available for
+*	that would put the system into an unsafe state. A process whose request asks for more of resource type j than is
+*	available waits on list j: only a release of resource type j gives more of it. A process whose request is unsafe
+*	waits on list m: any release, or a process ending, can make the state safe for it. Giving another process its
+*	request never makes a request that was not safe safe, so it wakes no one.
+*
+*	head[j] is the first process on list j and next[i] the one after process i, or -1. list[i] is the list process i
+*	is on, or -1. woken holds the processes taken off their lists since the last take_woken, whose requests have to be
+*	checked again.
+*/
+struct wait_lists {
+	int n;
+	int m;
+	int* head;
+	int* next;
+	int* list;
+	int* woken;
+	int n_woken;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function allocates empty lists for n processes and m resource types. It returns 0 on success and -1 if the
+*	memory could not be allocated.
+*/
+int init_wait_lists(struct wait_lists* waits, int n, int m);
+
+/*
+*	This function puts process i on the list of resource type j, the first one there is not enough available of for
+*	its request, or on the list of unsafe requests if j is -1 (see request_shortage in bankers.h)
+*/
+void wait_on(struct wait_lists* waits, int i, int j);
+
+/*
+*	This function wakes the processes that wait for resource type j and the ones whose requests were unsafe, once
+*	resource type j has been released
+*/
+void wake_resource(struct wait_lists* waits, int j);
+
+/*
+*	This function wakes the processes whose requests were unsafe, once a process has ended
+*/
+void wake_unsafe(struct wait_lists* waits);
+
+/*
+*	This function returns how many processes were woken since it was last called, and puts them at the start of woken
+*	in the order of the processes. They stay there until the next process is woken.
+*/
+int take_woken(struct wait_lists* waits);
+
+/*
+*	This function frees the memory of the lists
+*/
+void destroy_wait_lists(struct wait_lists* waits);
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "word_table.h"
+
+#define TRUE (1 == 1)
+#define FALSE (1 == 0)
+
+/*
+*	A word and its ID, for sorting the words
+*/
+struct ranked_word {
+	const char* word;
+	int id;
+};
+
+/*
+*	Comparator function for qsort in rank_words
+*/
+static int ranked_word_comp(const void* p1, const void* p2) {
+	return strcmp(((const struct ranked_word*)p1)->word, ((const struct ranked_word*)p2)->word);
+}
+
+/*
+*	This function returns the FNV-1a hash of the word
+*/
+static uint32_t hash_word(const char* word) {
+	uint32_t hash = 2166136261u;
+	for (const unsigned char* c = (const unsigned char*)word; *c != '\0'; c++) {
+		hash ^= *c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/*
+*	This function returns the slot of the word in the hash table: the slot that holds its ID, or the empty slot where
+*	its ID would go
+*/
+static int find_slot(struct word_table* table, const char* word) {
+	int slot = (int)(hash_word(word) & (uint32_t)(table->n_slots - 1));
+	while (table->slots[slot] != -1 && strcmp(table->words[table->slots[slot]], word) != 0) {
+		slot = (slot + 1) & (table->n_slots - 1);
+	}
+	return slot;
+}
+
+/*
+*	This function doubles the number of slots of the hash table, and puts every ID in its new slot
+*/
+static int grow_slots(struct word_table* table) {
+	int* slots = (int*)malloc(sizeof(int) * 2 * table->n_slots);
+	if (slots == NULL) {
+		fprintf(stderr, "could not allocate %d slots for the word table\n", 2 * table->n_slots);
+		return -1;
+	}
+	free(table->slots);
+	table->slots = slots;
+	table->n_slots *= 2;
+	memset(table->slots, -1, sizeof(int) * table->n_slots);
+	for (int id = 0; id < table->n_words; id++) {
+		table->slots[find_slot(table, table->words[id])] = id;
+	}
+	return 0;
+}
+
+/*
+*	This function sets up an empty table. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_word_table(struct word_table* table) {
+	table->words = NULL;
+	table->rank = NULL;
+	table->n_words = 0;
+	table->capacity = 0;
+	table->n_slots = 64;
+	table->slots = (int*)malloc(sizeof(int) * table->n_slots);
+	if (table->slots == NULL) {
+		fprintf(stderr, "could not allocate the word table\n");
+		return -1;
+	}
+	memset(table->slots, -1, sizeof(int) * table->n_slots);
+	return 0;
+}
+
+/*
+*	This function returns the ID of the word, adding it to the table if it is not there yet, or -1 if the memory could
+*	not be allocated
+*/
+int intern_word(struct word_table* table, const char* word) {
+	int slot = find_slot(table, word);
+	if (table->slots[slot] != -1) {
+		return table->slots[slot];
+	}
+
+	if (table->n_words == table->capacity) {
+		int capacity = table->capacity == 0 ? 16 : 2 * table->capacity;
+		char** words = (char**)realloc(table->words, sizeof(char*) * capacity);
+		if (words == NULL) {
+			fprintf(stderr, "could not allocate %d words for the word table\n", capacity);
+			return -1;
+		}
+		table->words = words;
+		int* rank = (int*)realloc(table->rank, sizeof(int) * capacity);
+		if (rank == NULL) {
+			fprintf(stderr, "could not allocate %d words for the word table\n", capacity);
+			return -1;
+		}
+		table->rank = rank;
+		table->capacity = capacity;
+	}
+	int id = table->n_words;
+	table->words[id] = strdup(word);
+	if (table->words[id] == NULL) {
+		fprintf(stderr, "could not allocate the word %s for the word table\n", word);
+		return -1;
+	}
+	table->rank[id] = id;
+	table->n_words++;
+	table->slots[slot] = id;
+
+	// keep the hash table at most half full
+	if (2 * table->n_words > table->n_slots && grow_slots(table) == -1) {
+		return -1;
+	}
+	return id;
+}
+
+/*
+*	This function gives every word its rank in alphabetical order. It has to run again after new words are interned.
+*	It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int rank_words(struct word_table* table) {
+	struct ranked_word* sorted = (struct ranked_word*)malloc(sizeof(struct ranked_word) * (table->n_words + 1));
+	if (sorted == NULL) {
+		fprintf(stderr, "could not allocate the ranks of %d words\n", table->n_words);
+		return -1;
+	}
+	for (int id = 0; id < table->n_words; id++) {
+		sorted[id].word = table->words[id];
+		sorted[id].id = id;
+	}
+	qsort(sorted, table->n_words, sizeof(struct ranked_word), ranked_word_comp);
+	for (int k = 0; k < table->n_words; k++) {
+		table->rank[sorted[k].id] = k;
+	}
+	free(sorted);
+	return 0;
+}
+
+/*
+*	This function frees the memory of the table
+*/
+void destroy_word_table(struct word_table* table) {
+	for (int id = 0; id < table->n_words; id++) {
+		free(table->words[id]);
+	}
+	free(table->words);
+	free(table->rank);
+	free(table->slots);
+	table->words = NULL;
+	table->rank = NULL;
+	table->slots = NULL;
+	table->n_words = 0;
+	table->capacity = 0;
+}
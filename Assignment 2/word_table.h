@@ -0,0 +1,46 @@
+/*
+*	The word table holds every name of a resource once. A name is interned when the word file is read, and from then
+*	on a resource is the 32-bit ID of its name: the ID is what the resource stacks hold and what the messages between
+*	the commanding process and the children carry, and only the master string turns it back into the name.
+*
+*	words[id] is the name with that ID, and rank[id] its place among all the names in alphabetical order, once
+*	rank_words has run, so that names can be sorted by comparing integers. slots is a hash table of the IDs, with -1
+*	for an empty slot, so that interning a name does not search the table.
+*/
+struct word_table {
+	char** words;
+	int* rank;
+	int n_words;
+	int capacity;
+	int* slots;
+	int n_slots;
+};
+
+
+
+
+
+
+
+
+/*
+*	This function sets up an empty table. It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int init_word_table(struct word_table* table);
+
+/*
+*	This function returns the ID of the word, adding it to the table if it is not there yet, or -1 if the memory could
+*	not be allocated
+*/
+int intern_word(struct word_table* table, const char* word);
+
+/*
+*	This function gives every word its rank in alphabetical order. It has to run again after new words are interned.
+*	It returns 0 on success and -1 if the memory could not be allocated.
+*/
+int rank_words(struct word_table* table);
+
+/*
+*	This function frees the memory of the table
+*/
+void destroy_word_table(struct word_table* table);